@@ -0,0 +1,388 @@
+//
+// Battle.cpp
+// Combat resolution for Advance orders.
+//
+
+#include "Battle.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define RISK_COMBAT_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define RISK_TARGET_AVX2
+#else
+#define RISK_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+// ============================================================================
+// BattleTable Implementation
+// ============================================================================
+
+BattleTable::BattleTable() {
+    for (auto& side : rows) {
+        side.reset(new std::atomic<const Row*>[MAX_TABLE_ARMIES + 1]);
+        for (int i = 0; i <= MAX_TABLE_ARMIES; ++i) {
+            side[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+}
+
+BattleTable::~BattleTable() {
+    for (auto& side : rows) {
+        for (int i = 0; i <= MAX_TABLE_ARMIES; ++i) {
+            delete side[i].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+BattleTable& BattleTable::shared() {
+    static BattleTable table;
+    return table;
+}
+
+// Builds the alias table for Binomial(units, killChance) using Vose's method.
+BattleTable::Row BattleTable::buildRow(int units, double killChance) {
+    const int size = units + 1;
+    Row r;
+    r.pmf.resize(size);
+    r.threshold.assign(size, UINT32_MAX);
+    r.alias.resize(size);
+
+    const double logP = std::log(killChance);
+    const double logQ = std::log(1.0 - killChance);
+    const double logNFact = std::lgamma(units + 1.0);
+    for (int k = 0; k < size; ++k) {
+        r.pmf[k] = std::exp(logNFact - std::lgamma(k + 1.0) - std::lgamma(units - k + 1.0)
+                            + k * logP + (units - k) * logQ);
+        r.alias[k] = static_cast<uint16_t>(k);
+    }
+
+    std::vector<double> scaled(size);
+    std::vector<int> small, large;
+    for (int k = 0; k < size; ++k) {
+        scaled[k] = r.pmf[k] * size;
+        (scaled[k] < 1.0 ? small : large).push_back(k);
+    }
+
+    while (!small.empty() && !large.empty()) {
+        const int s = small.back();
+        small.pop_back();
+        const int l = large.back();
+
+        r.threshold[s] = static_cast<uint32_t>(std::min(scaled[s] * 4294967296.0, 4294967295.0));
+        r.alias[s] = static_cast<uint16_t>(l);
+
+        scaled[l] -= 1.0 - scaled[s];
+        if (scaled[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // Whatever is left is a full column up to rounding error; alias[k] == k already covers it.
+    return r;
+}
+
+const BattleTable::Row& BattleTable::row(Side side, int units) {
+    const Row* r = rows[side][units].load(std::memory_order_acquire);
+    if (r) return *r;
+
+    std::lock_guard<std::mutex> lock(buildMutex);
+    r = rows[side][units].load(std::memory_order_relaxed);
+    if (!r) {
+        const double chance = side == AttackerRolls ? ATTACKER_KILL_CHANCE : DEFENDER_KILL_CHANCE;
+        r = new Row(buildRow(units, chance));
+        rows[side][units].store(r, std::memory_order_release);
+    }
+    return *r;
+}
+
+int BattleTable::sampleRow(const Row& r, std::mt19937& rng) {
+    const uint64_t column = (static_cast<uint64_t>(rng()) * r.alias.size()) >> 32;
+    const uint32_t coin = static_cast<uint32_t>(rng());
+    return coin < r.threshold[column] ? static_cast<int>(column) : r.alias[column];
+}
+
+int BattleTable::sampleKills(Side side, int units, std::mt19937& rng) {
+    if (units <= 0) return 0;
+    if (units > MAX_TABLE_ARMIES) {
+        const double chance = side == AttackerRolls ? ATTACKER_KILL_CHANCE : DEFENDER_KILL_CHANCE;
+        std::binomial_distribution<int> dist(units, chance);
+        return dist(rng);
+    }
+    return sampleRow(row(side, units), rng);
+}
+
+BattleOutcome BattleTable::sample(int attackers, int defenders, std::mt19937& rng) {
+    BattleOutcome outcome{0, 0};
+    if (attackers <= 0) return outcome;
+    if (defenders < 0) defenders = 0;
+
+    outcome.defenderLosses = std::min(sampleKills(AttackerRolls, attackers, rng), defenders);
+    outcome.attackerLosses = std::min(sampleKills(DefenderRolls, defenders, rng), attackers);
+    return outcome;
+}
+
+double BattleTable::probability(int attackers, int defenders, int attackerLosses, int defenderLosses) {
+    if (attackers < 0 || defenders < 0 || attackerLosses < 0 || defenderLosses < 0) return 0.0;
+    if (attackers > MAX_TABLE_ARMIES || defenders > MAX_TABLE_ARMIES) return 0.0;
+    if (attackerLosses > attackers || defenderLosses > defenders) return 0.0;
+
+    // Clamped losses absorb the tail of the binomial: losing the whole stack covers every roll
+    // with at least that many kills.
+    auto marginal = [](const Row& r, int losses, int cap) {
+        if (losses < cap) return r.pmf[losses];
+        double tail = 0.0;
+        for (size_t k = static_cast<size_t>(cap); k < r.pmf.size(); ++k) tail += r.pmf[k];
+        return tail;
+    };
+
+    const double pDefender = marginal(row(AttackerRolls, attackers), defenderLosses, defenders);
+    const double pAttacker = marginal(row(DefenderRolls, defenders), attackerLosses, attackers);
+    return pDefender * pAttacker;
+}
+
+double BattleTable::conquestProbability(int attackers, int defenders) {
+    if (attackers <= 0 || attackers > MAX_TABLE_ARMIES || defenders > MAX_TABLE_ARMIES) return 0.0;
+    if (defenders <= 0) return 1.0;
+
+    const Row& attack = row(AttackerRolls, attackers);
+    double allDefendersDie = 0.0;
+    for (size_t k = static_cast<size_t>(defenders); k < attack.pmf.size(); ++k) allDefendersDie += attack.pmf[k];
+
+    const Row& defend = row(DefenderRolls, defenders);
+    double attackerSurvives = 0.0;
+    for (int k = 0; k < attackers && k < static_cast<int>(defend.pmf.size()); ++k) attackerSurvives += defend.pmf[k];
+
+    return allDefendersDie * attackerSurvives;
+}
+
+void BattleTable::reserve(int maxArmies) {
+    maxArmies = std::min(maxArmies, MAX_TABLE_ARMIES);
+    for (int n = 1; n <= maxArmies; ++n) {
+        row(AttackerRolls, n);
+        row(DefenderRolls, n);
+    }
+}
+
+// ============================================================================
+// CombatKernel Implementation
+// ============================================================================
+
+namespace {
+
+uint32_t killThreshold(double killChance) {
+    if (killChance <= 0.0) return 0;
+    if (killChance >= 1.0) return UINT32_MAX;
+    return static_cast<uint32_t>(killChance * 4294967296.0);
+}
+
+inline uint32_t xorshift32(uint32_t& x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// Scalar emulation of the SIMD lanes: every step advances all eight streams and only
+// the lanes still holding a unit count towards the result.
+int countKillsScalar(uint32_t* state, int units, uint32_t threshold) {
+    int kills = 0;
+    for (int base = 0; base < units; base += CombatKernel::LANES) {
+        for (int lane = 0; lane < CombatKernel::LANES; ++lane) {
+            const uint32_t roll = xorshift32(state[lane]);
+            if (base + lane < units && roll < threshold) ++kills;
+        }
+    }
+    return kills;
+}
+
+// One battle per lane: lane i rolls units[i] times.
+void countKillsPerLaneScalar(uint32_t* state, const int* units, uint32_t threshold, int* kills) {
+    const int steps = *std::max_element(units, units + CombatKernel::LANES);
+    for (int lane = 0; lane < CombatKernel::LANES; ++lane) kills[lane] = 0;
+    for (int step = 0; step < steps; ++step) {
+        for (int lane = 0; lane < CombatKernel::LANES; ++lane) {
+            const uint32_t roll = xorshift32(state[lane]);
+            if (step < units[lane] && roll < threshold) ++kills[lane];
+        }
+    }
+}
+
+#ifdef RISK_COMBAT_X86
+
+RISK_TARGET_AVX2 inline __m256i xorshift32x8(__m256i x) {
+    x = _mm256_xor_si256(x, _mm256_slli_epi32(x, 13));
+    x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 17));
+    x = _mm256_xor_si256(x, _mm256_slli_epi32(x, 5));
+    return x;
+}
+
+// AVX2 has no unsigned compare, so both sides are biased into signed range first.
+RISK_TARGET_AVX2 inline __m256i below(__m256i roll, __m256i biasedThreshold) {
+    const __m256i bias = _mm256_set1_epi32(INT_MIN);
+    return _mm256_cmpgt_epi32(biasedThreshold, _mm256_xor_si256(roll, bias));
+}
+
+RISK_TARGET_AVX2 int countKillsAvx2(uint32_t* state, int units, uint32_t threshold) {
+    __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(state));
+    const __m256i biasedThreshold = _mm256_set1_epi32(static_cast<int>(threshold ^ 0x80000000u));
+    const __m256i laneIndex = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i total = _mm256_setzero_si256();
+
+    for (int base = 0; base < units; base += CombatKernel::LANES) {
+        x = xorshift32x8(x);
+        const __m256i hit = below(x, biasedThreshold);
+        const __m256i active = _mm256_cmpgt_epi32(_mm256_set1_epi32(units - base), laneIndex);
+        total = _mm256_sub_epi32(total, _mm256_and_si256(hit, active));
+    }
+
+    _mm256_store_si256(reinterpret_cast<__m256i*>(state), x);
+    alignas(32) int counts[CombatKernel::LANES];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(counts), total);
+    int kills = 0;
+    for (int c : counts) kills += c;
+    return kills;
+}
+
+RISK_TARGET_AVX2 void countKillsPerLaneAvx2(uint32_t* state, const int* units, uint32_t threshold, int* kills) {
+    const int steps = *std::max_element(units, units + CombatKernel::LANES);
+    __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(state));
+    const __m256i biasedThreshold = _mm256_set1_epi32(static_cast<int>(threshold ^ 0x80000000u));
+    const __m256i unitCounts = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(units));
+    __m256i total = _mm256_setzero_si256();
+
+    for (int step = 0; step < steps; ++step) {
+        x = xorshift32x8(x);
+        const __m256i hit = below(x, biasedThreshold);
+        const __m256i active = _mm256_cmpgt_epi32(unitCounts, _mm256_set1_epi32(step));
+        total = _mm256_sub_epi32(total, _mm256_and_si256(hit, active));
+    }
+
+    _mm256_store_si256(reinterpret_cast<__m256i*>(state), x);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(kills), total);
+}
+
+#endif
+
+int countKills(CombatKernel::Path path, uint32_t* state, int units, uint32_t threshold) {
+#ifdef RISK_COMBAT_X86
+    if (path == CombatKernel::Path::Avx2) return countKillsAvx2(state, units, threshold);
+#endif
+    return countKillsScalar(state, units, threshold);
+}
+
+void countKillsPerLane(CombatKernel::Path path, uint32_t* state, const int* units, uint32_t threshold, int* kills) {
+#ifdef RISK_COMBAT_X86
+    if (path == CombatKernel::Path::Avx2) {
+        countKillsPerLaneAvx2(state, units, threshold, kills);
+        return;
+    }
+#endif
+    countKillsPerLaneScalar(state, units, threshold, kills);
+}
+
+}
+
+CombatKernel::CombatKernel(uint32_t seed) : path(avx2Supported() ? Path::Avx2 : Path::Scalar) {
+    this->seed(seed);
+}
+
+// Seeds each lane from a splitmix sequence; xorshift must never start at zero.
+void CombatKernel::seed(uint32_t seed) {
+    uint64_t z = seed;
+    for (int lane = 0; lane < LANES; ++lane) {
+        z += 0x9E3779B97F4A7C15ull;
+        uint64_t mixed = z;
+        mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+        mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+        mixed ^= mixed >> 31;
+        lanes[lane] = static_cast<uint32_t>(mixed) | 1u;
+    }
+}
+
+std::array<uint32_t, CombatKernel::LANES> CombatKernel::getLanes() const {
+    std::array<uint32_t, LANES> state;
+    std::copy(lanes, lanes + LANES, state.begin());
+    return state;
+}
+
+void CombatKernel::setLanes(const std::array<uint32_t, LANES>& state) {
+    for (int lane = 0; lane < LANES; ++lane) {
+        lanes[lane] = state[lane] != 0 ? state[lane] : 1u;  // a zero lane would stay zero forever
+    }
+}
+
+void CombatKernel::setPath(Path p) {
+    path = (p == Path::Avx2 && !avx2Supported()) ? Path::Scalar : p;
+}
+
+bool CombatKernel::avx2Supported() {
+#if defined(RISK_COMBAT_X86) && defined(_MSC_VER) && !defined(__clang__)
+    static const bool supported = [] {
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx) return false;
+        if ((_xgetbv(0) & 0x6) != 0x6) return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+    }();
+    return supported;
+#elif defined(RISK_COMBAT_X86)
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+int CombatKernel::countKills(int units, double killChance) {
+    if (units <= 0) return 0;
+    return ::countKills(path, lanes, units, killThreshold(killChance));
+}
+
+BattleOutcome CombatKernel::resolve(int attackers, int defenders) {
+    BattleOutcome outcome{0, 0};
+    if (attackers <= 0) return outcome;
+    if (defenders < 0) defenders = 0;
+
+    const uint32_t attackThreshold = killThreshold(BattleTable::ATTACKER_KILL_CHANCE);
+    const uint32_t defendThreshold = killThreshold(BattleTable::DEFENDER_KILL_CHANCE);
+    outcome.defenderLosses = std::min(::countKills(path, lanes, attackers, attackThreshold), defenders);
+    outcome.attackerLosses = std::min(::countKills(path, lanes, defenders, defendThreshold), attackers);
+    return outcome;
+}
+
+void CombatKernel::resolveBatch(const BattleRequest* battles, BattleOutcome* outcomes, size_t count) {
+    const uint32_t attackThreshold = killThreshold(BattleTable::ATTACKER_KILL_CHANCE);
+    const uint32_t defendThreshold = killThreshold(BattleTable::DEFENDER_KILL_CHANCE);
+
+    for (size_t first = 0; first < count; first += LANES) {
+        alignas(32) int attackers[LANES] = {};
+        alignas(32) int defenders[LANES] = {};
+        alignas(32) int defenderLosses[LANES];
+        alignas(32) int attackerLosses[LANES];
+
+        const size_t group = std::min<size_t>(LANES, count - first);
+        for (size_t i = 0; i < group; ++i) {
+            attackers[i] = std::max(0, battles[first + i].attackers);
+            defenders[i] = attackers[i] > 0 ? std::max(0, battles[first + i].defenders) : 0;
+        }
+
+        countKillsPerLane(path, lanes, attackers, attackThreshold, defenderLosses);
+        countKillsPerLane(path, lanes, defenders, defendThreshold, attackerLosses);
+
+        for (size_t i = 0; i < group; ++i) {
+            outcomes[first + i].defenderLosses = std::min(defenderLosses[i], defenders[i]);
+            outcomes[first + i].attackerLosses = std::min(attackerLosses[i], attackers[i]);
+        }
+    }
+}
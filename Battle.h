@@ -0,0 +1,148 @@
+//
+// Battle.h
+// Combat resolution for Advance orders.
+//
+
+#ifndef COMP345_RISK_BATTLE_H
+#define COMP345_RISK_BATTLE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+/**
+ * Result of a single battle: how many units each side lost.
+ */
+struct BattleOutcome {
+    int attackerLosses;
+    int defenderLosses;
+};
+
+/**
+ * Precomputed outcome distributions for battles, keyed by (attackers, defenders).
+ *
+ * Every attacking unit has a 60% chance of killing a defending unit and every defending
+ * unit has a 70% chance of killing an attacking unit. The rolls are independent, so the
+ * defender losses of a battle follow Binomial(attackers, 0.6) and the attacker losses follow
+ * Binomial(defenders, 0.7). The joint (attackers, defenders) distribution is the product of
+ * those two marginals, so the table stores one alias table per army count and side instead
+ * of one per pair. Rows are built lazily the first time a count is seen and never change
+ * afterwards, which makes sampling lock-free and O(1): two random words per side.
+ *
+ * Army counts above MAX_TABLE_ARMIES fall back to std::binomial_distribution.
+ */
+class BattleTable {
+public:
+    static constexpr double ATTACKER_KILL_CHANCE = 0.6;
+    static constexpr double DEFENDER_KILL_CHANCE = 0.7;
+    static constexpr int MAX_TABLE_ARMIES = 1024;
+
+    BattleTable();
+    BattleTable(const BattleTable& other) = delete;
+    BattleTable& operator=(const BattleTable& other) = delete;
+    ~BattleTable();
+
+    /**
+     * Samples the losses of a battle between the given stacks.
+     * Losses are clamped to the size of the losing stack.
+     */
+    BattleOutcome sample(int attackers, int defenders, std::mt19937& rng);
+
+    /**
+     * Probability that exactly the given losses happen in a battle between the given stacks.
+     */
+    double probability(int attackers, int defenders, int attackerLosses, int defenderLosses);
+
+    /**
+     * Probability that the attacker kills every defender while keeping at least one unit.
+     */
+    double conquestProbability(int attackers, int defenders);
+
+    /**
+     * Builds every row up to the given army count so simulations don't pay for it mid-search.
+     */
+    void reserve(int maxArmies);
+
+    /**
+     * Table shared by every simulation in the process.
+     */
+    static BattleTable& shared();
+
+private:
+    // One alias table for Binomial(n, p): entry k is returned with probability pmf[k].
+    struct Row {
+        std::vector<uint32_t> threshold;  // keep column k if the second random word is below this
+        std::vector<uint16_t> alias;      // otherwise return alias[k]
+        std::vector<double> pmf;
+    };
+
+    enum Side { AttackerRolls = 0, DefenderRolls = 1 };
+
+    std::array<std::unique_ptr<std::atomic<const Row*>[]>, 2> rows;
+    std::mutex buildMutex;
+
+    const Row& row(Side side, int units);
+    static Row buildRow(int units, double killChance);
+    static int sampleRow(const Row& r, std::mt19937& rng);
+    int sampleKills(Side side, int units, std::mt19937& rng);
+};
+
+/**
+ * One battle in a batch handed to CombatKernel::resolveBatch().
+ */
+struct BattleRequest {
+    int attackers;
+    int defenders;
+};
+
+/**
+ * Exact battle resolution: every unit rolls its own Bernoulli trial.
+ *
+ * The kernel keeps eight independent xorshift32 streams, one per SIMD lane, and counts kills
+ * eight rolls at a time. A single battle spreads its units across the lanes; a batch gives each
+ * lane its own battle so many small battles of a turn are resolved together. The AVX2 path is
+ * picked at runtime when the CPU supports it and the scalar path emulates the same lanes, so
+ * both produce identical outcomes for the same seed.
+ */
+class CombatKernel {
+public:
+    enum class Path { Scalar, Avx2 };
+    static constexpr int LANES = 8;
+
+    explicit CombatKernel(uint32_t seed = 0x9E3779B9u);
+
+    void seed(uint32_t seed);
+
+    /**
+     * State of the eight streams, for checkpoints. Restoring it continues the exact same rolls.
+     */
+    std::array<uint32_t, LANES> getLanes() const;
+    void setLanes(const std::array<uint32_t, LANES>& state);
+
+    BattleOutcome resolve(int attackers, int defenders);
+    void resolveBatch(const BattleRequest* battles, BattleOutcome* outcomes, size_t count);
+
+    /**
+     * Number of successes among the given number of Bernoulli trials.
+     */
+    int countKills(int units, double killChance);
+
+    Path getPath() const { return path; }
+    // Requests a path; asking for AVX2 on a CPU without it keeps the scalar path.
+    void setPath(Path p);
+
+    static bool avx2Supported();
+
+private:
+    alignas(32) uint32_t lanes[LANES];
+    Path path;
+};
+
+void testBattleTable();
+void testCombatKernel();
+
+#endif // COMP345_RISK_BATTLE_H
@@ -0,0 +1,149 @@
+//
+// BattleDriver.cpp
+// Driver for the battle outcome tables.
+//
+
+#include "Battle.h"
+#include "GameState.h"
+#include "Orders.h"
+#include "Player.h"
+#include "DriverCheck.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Resolves the same battles on the given path and returns battles per second.
+double battlesPerSecond(CombatKernel::Path path, const std::vector<BattleRequest>& battles, bool batched, long long& checksum) {
+    CombatKernel kernel(345);
+    kernel.setPath(path);
+    std::vector<BattleOutcome> outcomes(battles.size());
+    const int rounds = 20;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        if (batched) {
+            kernel.resolveBatch(battles.data(), outcomes.data(), battles.size());
+        } else {
+            for (size_t i = 0; i < battles.size(); ++i) {
+                outcomes[i] = kernel.resolve(battles[i].attackers, battles[i].defenders);
+            }
+        }
+        for (const auto& o : outcomes) checksum += o.attackerLosses * 31 + o.defenderLosses;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return battles.size() * rounds / elapsed.count();
+}
+
+}
+
+void testBattleTable() {
+    std::cout << "=== Battle Table Demo ===\n";
+
+    BattleTable& table = BattleTable::shared();
+    std::mt19937 rng(345);
+
+    const int stacks[][2] = {{3, 2}, {10, 10}, {20, 8}, {100, 60}};
+    const int trials = 100000;
+
+    for (const auto& stack : stacks) {
+        const int attackers = stack[0];
+        const int defenders = stack[1];
+        int conquests = 0;
+        for (int i = 0; i < trials; ++i) {
+            BattleOutcome outcome = table.sample(attackers, defenders, rng);
+            if (outcome.defenderLosses == defenders && outcome.attackerLosses < attackers) {
+                ++conquests;
+            }
+        }
+        std::cout << attackers << " attackers vs " << defenders << " defenders: conquest rate "
+                  << static_cast<double>(conquests) / trials << " (exact "
+                  << table.conquestProbability(attackers, defenders) << ")\n";
+    }
+
+    std::cout << "=== End of Battle Table Demo ===\n";
+}
+
+void testCombatKernel() {
+    std::cout << "=== Combat Kernel Benchmark ===\n";
+    std::cout << "AVX2 " << (CombatKernel::avx2Supported() ? "available" : "not available, both runs use the scalar path") << "\n";
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> small(1, 12);
+    std::uniform_int_distribution<int> large(50, 400);
+
+    std::vector<BattleRequest> skirmishes(20000);
+    for (auto& b : skirmishes) b = {small(rng), small(rng)};
+    std::vector<BattleRequest> sieges(2000);
+    for (auto& b : sieges) b = {large(rng), large(rng)};
+
+    struct Run { const char* label; const std::vector<BattleRequest>* battles; bool batched; };
+    const Run runs[] = {
+        {"small battles, one at a time", &skirmishes, false},
+        {"small battles, batched by lane", &skirmishes, true},
+        {"large battles, one at a time", &sieges, false},
+    };
+
+    for (const auto& run : runs) {
+        long long scalarSum = 0, simdSum = 0;
+        const double scalar = battlesPerSecond(CombatKernel::Path::Scalar, *run.battles, run.batched, scalarSum);
+        const double simd = battlesPerSecond(CombatKernel::Path::Avx2, *run.battles, run.batched, simdSum);
+        std::cout << run.label << ": scalar " << static_cast<long long>(scalar) << " battles/s, dispatched "
+                  << static_cast<long long>(simd) << " battles/s (x" << simd / scalar << ")"
+                  << (scalarSum == simdSum ? "" : " [MISMATCH]") << "\n";
+    }
+
+    // Two attacks on separate fronts go through the batch; a third from an attacked territory waits.
+    Map map("Battle demo", {{"Front", 1}}, {
+        {"A", "Front", {"B"}}, {"B", "Front", {"A", "E"}},
+        {"C", "Front", {"D"}}, {"D", "Front", {"C"}},
+        {"E", "Front", {"B"}},
+    });
+    Player ann("Ann");
+    Player bo("Bo");
+    auto& nodes = map.getTerritoryNodes();
+    const int armies[] = {10, 4, 10, 4, 3};
+    for (int t = 0; t < 5; ++t) {
+        (t == 1 || t == 3 ? bo : ann).addTerritory(&nodes[t]);
+        nodes[t].armies = armies[t];
+    }
+    GameState state(&map, {&ann, &bo}, nullptr, 345);
+    ann.issueOrder(new Advance(10, "A", "B"));
+    ann.issueOrder(new Advance(10, "C", "D"));
+    ann.issueOrder(new Advance(3, "E", "B"));
+
+    CombatKernel expected(345);
+    const BattleRequest fronts[] = {{10, 4}, {10, 4}};
+    BattleOutcome outcomes[2];
+    expected.resolveBatch(fronts, outcomes, 2);
+
+    ann.getOrdersList()->executeAll(state);
+    // The third order may fight over B afterwards, so the first battle is read off its source.
+    bool matches = true;
+    for (int i = 0; i < 2; ++i) {
+        const Map::territoryNode& source = nodes[2 * i];
+        const Map::territoryNode& target = nodes[2 * i + 1];
+        const int survivors = 10 - outcomes[i].attackerLosses;
+        const bool conquered = outcomes[i].defenderLosses >= 4 && survivors > 0;
+        matches = matches && source.armies == (conquered ? 0 : survivors);
+        if (i == 1) {
+            matches = matches && target.owner == (conquered ? &ann : &bo) &&
+                      target.armies == (conquered ? survivors : 4 - outcomes[i].defenderLosses);
+        }
+    }
+    check(matches, "attacks on separate fronts are resolved in one batch of the combat kernel's lanes");
+    check(ann.getOrdersList()->getOrder(2)->isExecuted() && nodes[4].armies <= 3,
+          "an attack on a territory already fought over this turn still executes after the batch");
+
+    std::cout << "=== End of Combat Kernel Benchmark ===\n";
+}
+
+/**
+int main() {
+    testBattleTable();
+    testCombatKernel();
+    return 0;
+}
+ */
@@ -0,0 +1,127 @@
+//
+// BinaryIO.h
+// Little-endian encoding helpers shared by the journal and checkpoint formats.
+//
+
+#ifndef COMP345_RISK_BINARYIO_H
+#define COMP345_RISK_BINARYIO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * Appends little-endian integers and length-prefixed strings to a byte buffer.
+ */
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<char>& out) : out(out) {}
+
+    void u8(uint8_t value) { out.push_back(static_cast<char>(value)); }
+    void u16(uint16_t value) { put(value, 2); }
+    void u32(uint32_t value) { put(value, 4); }
+    void i32(int32_t value) { put(static_cast<uint32_t>(value), 4); }
+    void u64(uint64_t value) { put(value, 8); }
+    void bytes(const void* data, size_t size) {
+        const char* begin = static_cast<const char*>(data);
+        out.insert(out.end(), begin, begin + size);
+    }
+    void str(const std::string& value) {
+        u32(static_cast<uint32_t>(value.size()));
+        bytes(value.data(), value.size());
+    }
+
+    // Overwrites 4 bytes written earlier, e.g. a length only known afterwards.
+    void patchU32(size_t offset, uint32_t value) {
+        for (int i = 0; i < 4; ++i) out[offset + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+
+    size_t size() const { return out.size(); }
+
+private:
+    std::vector<char>& out;
+
+    void put(uint64_t value, int count) {
+        for (int i = 0; i < count; ++i) out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+};
+
+/**
+ * Reads what ByteWriter wrote. Reading past the end yields zeros and clears ok(), so a decoder can
+ * read a whole structure and check once at the end.
+ */
+class ByteReader {
+public:
+    ByteReader(const char* data, size_t size) : data(data), end(size), pos(0), good(true) {}
+
+    uint8_t u8() { return static_cast<uint8_t>(get(1)); }
+    uint16_t u16() { return static_cast<uint16_t>(get(2)); }
+    uint32_t u32() { return static_cast<uint32_t>(get(4)); }
+    int32_t i32() { return static_cast<int32_t>(static_cast<uint32_t>(get(4))); }
+    uint64_t u64() { return get(8); }
+    bool bytes(void* target, size_t size) {
+        if (!take(size)) return false;
+        for (size_t i = 0; i < size; ++i) static_cast<char*>(target)[i] = data[pos - size + i];
+        return true;
+    }
+    std::string str() {
+        const uint32_t size = u32();
+        if (!take(size)) return std::string();
+        return std::string(data + pos - size, size);
+    }
+
+    bool ok() const { return good; }
+    size_t position() const { return pos; }
+    size_t remaining() const { return end - pos; }
+
+private:
+    const char* data;
+    size_t end;
+    size_t pos;
+    bool good;
+
+    bool take(size_t size) {
+        if (!good || end - pos < size) {
+            good = false;
+            return false;
+        }
+        pos += size;
+        return true;
+    }
+
+    uint64_t get(int count) {
+        if (!take(static_cast<size_t>(count))) return 0;
+        uint64_t value = 0;
+        for (int i = 0; i < count; ++i) {
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(data[pos - count + i])) << (8 * i);
+        }
+        return value;
+    }
+};
+
+/**
+ * Reads a whole file with a single read. False if it can't be opened or read.
+ */
+inline bool readFileBytes(const std::string& path, std::vector<char>& out) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    const std::streamoff size = file.tellg();
+    if (size < 0) return false;
+    out.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    return out.empty() || static_cast<bool>(file.read(out.data(), static_cast<std::streamsize>(out.size())));
+}
+
+/**
+ * Writes a whole buffer with a single write, replacing the file. False if it can't be written.
+ */
+inline bool writeFileBytes(const std::string& path, const std::vector<char>& data) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file.flush());
+}
+
+#endif // COMP345_RISK_BINARYIO_H
@@ -1,255 +1,212 @@
 #include "Cards.h"
 #include "Player.h"
+#include "PlayerStrategies.h"
+#include "GameState.h"
+#include "Map.h"
 #include <iostream>
+#include <sstream>
 
 using namespace std;
 
-//parameterized constructor for Card
-Card::Card(const string& t)
-: type(new string(CardsUtil::normalizeType(t))) {}
-
-//copy constructor for Card
-Card::Card(const Card& other)
-: type(new string(*other.type)) {}
+//constructor for Card
+Card::Card(CardType t) : type(t) {}
 
-//assignment operator for Card
-Card& Card::operator=(const Card& other) {
-    if (this != &other) {
-        *type = *other.type;
-    }
-    return *this;
+//parameterized constructor for Card
+Card::Card(const string& t) : type(CardType::Reinforcement) {
+    CardsUtil::parse(t, type);
 }
 
-//destructor for Card
-Card::~Card() {
-    cout << "Destroying card object: " << *type << "\n";
-    delete type;
+//getters for Card
+CardType Card::getType() const {
+    return type;
 }
 
-//getters for Card
-const string& Card::getType() const {
-    return *type;
+const char* Card::getName() const {
+    return CardsUtil::name(type);
 }
 
 //play() method: enables a player to use it during game play by creating
 //special orders. Once a card has been played, it is removed from the hand and put back into
 //the deck.
-void Card::play(Player* p, Deck* d, Hand* h) {
+bool Card::play(Player* p, Deck* d, Hand* h, const CardTarget& target) {
     if (!p || !d || !h) {
         cout << "[Card::play] Missing player/deck/hand context. No-op.\n";
-        return;
+        return false;
+    }
+    GameState* state = p->getGameState();
+    if (!state || !state->getMap()) {
+        cout << "[Card::play] " << p->getName() << " is not in a running game. No-op.\n";
+        return false;
+    }
+    if (h->count(type) == 0) {
+        cout << "[Card::play] Hand holds no '" << getName() << "' card. No-op.\n";
+        return false;
     }
 
-    string orderDesc;
-    if (*type == "bomb") orderDesc = "Bomb order created by card.";
-    else if (*type == "reinforcement") orderDesc = "Reinforcement order created by card.";
-    else if (*type == "blockade") orderDesc = "Blockade order created by card.";
-    else if (*type == "airlift") orderDesc = "Airlift order created by card.";
-    else if (*type == "diplomacy") orderDesc = "Negotiate/Diplomacy order created by card.";
-    else orderDesc = "Generic order created by card.";
-
-    if (*type == "bomb")
-        p->issueOrder(new Bomb("EnemyTerritory"));
-    else if (*type == "reinforcement")
-        p->issueOrder(new Deploy(5, "MyTerritory"));
-    else if (*type == "blockade")
-        p->issueOrder(new Blockade("MyTerritory"));
-    else if (*type == "airlift")
-        p->issueOrder(new Airlift(3, "Source", "Target"));
-    else if (*type == "diplomacy")
-        p->issueOrder(new Negotiate("TargetPlayer"));
-    else
-        p->issueOrder(new Advance(2, "Source", "Target"));
-
-    h->removeCard(this);
-    d->returnCard(this);
-
-    cout << "[Card::play] Played '" << *type << "': " << orderDesc << " Card returned to deck.\n";
+    const auto& nodes = state->getMap()->getTerritoryNodes();
+    const auto& players = state->getPlayers();
+    auto territory = [&](int id) -> const Map::territoryNode* {
+        return id >= 0 && static_cast<size_t>(id) < nodes.size() ? &nodes[id] : nullptr;
+    };
+    const Map::territoryNode* to = territory(target.territory);
+
+    Order* order = nullptr;
+    switch (type) {
+        case CardType::Bomb:
+            if (to) order = new Bomb(to->name);
+            break;
+        case CardType::Reinforcement:
+            if (to) order = new Deploy(REINFORCEMENT_ARMIES, to->name);
+            break;
+        case CardType::Blockade:
+            if (to) order = new Blockade(to->name);
+            break;
+        case CardType::Airlift:
+            if (const Map::territoryNode* from = territory(target.source)) {
+                if (to && target.armies > 0) order = new Airlift(target.armies, from->name, to->name);
+            }
+            break;
+        case CardType::Diplomacy:
+            if (target.player >= 0 && static_cast<size_t>(target.player) < players.size() &&
+                players[target.player] != p) {
+                order = new Negotiate(players[target.player]->getName());
+            }
+            break;
+    }
+    if (!order) {
+        cout << "[Card::play] No valid target for '" << getName() << "'. No-op.\n";
+        return false;
+    }
+
+    h->removeCard(type);
+    d->returnCard(type);
+    cout << "[Card::play] " << p->getName() << " played '" << getName() << "'. Deck size: " << d->size() << "\n";
+    p->issueOrder(order);
+    state->publish(GameEvent{GameEventType::CardPlayed, p, nullptr, nullptr, type});
+    return true;
+}
+
+bool Card::play(Player* p, Deck* d, Hand* h) {
+    PlayerStrategy* strategy = p ? p->getStrategy() : nullptr;
+    CardTarget target;
+    if (!strategy || !strategy->chooseCardTarget(type, target)) return false;
+    return play(p, d, h, target);
 }
 
 //stream insertion operator for Card
 ostream& operator<<(ostream& os, const Card& c) {
-    os << "Card(" << *c.type << ")";
+    os << "Card(" << c.getName() << ")";
     return os;
 }
 
 //default constructor for Deck
-Deck::Deck() : cards(new vector<Card*>) {}
+Deck::Deck() : rng(random_device{}()) {}
 
 //parameterized constructor for Deck
-Deck::Deck(int size) : cards(new vector<Card*>) {
-    const auto& types = CardsUtil::validTypes();
-    for (int i = 0; i < size; ++i) {
-        cards->push_back(new Card(types[static_cast<size_t>(i) % types.size()]));
-    }
-}
-
-//copy constructor for Deck
-Deck::Deck(const Deck& other) : cards(new vector<Card*>) {
-    cards->reserve(other.cards->size());
-    for (const auto* c : *other.cards) {
-        cards->push_back(new Card(*c));
-    }
-}
+Deck::Deck(int size) : Deck(size, random_device{}()) {}
 
-//stream insertion operator for Deck
-Deck& Deck::operator=(const Deck& other) {
-    if (this != &other) {
-        for (auto* c : *cards) delete c;
-        cards->clear();
-        for (const auto* c : *other.cards) {
-            cards->push_back(new Card(*c));
-        }
+//parameterized constructor for Deck with a fixed shuffle
+Deck::Deck(int size, uint32_t seed) : rng(seed) {
+    if (size <= 0) return;
+    cards.reserve(static_cast<size_t>(size));
+    for (int i = 0; i < size; ++i) {
+        cards.push_back(static_cast<CardType>(i % CARD_TYPE_COUNT));
     }
-    return *this;
-}
-
-//deconstructor for Deck
-Deck::~Deck() {
-    cout << "Deleting deck objects...\n";
-    for (auto* c : *cards) delete c;
-    delete cards;
-}
-
-//randomize the deck card contents
-mt19937& Deck::rng() {
-    static random_device rd;
-    static mt19937 gen(rd());
-    return gen;
 }
 
 //draw() method: allows a player to draw a card at random from the cards
 //remaining in the deck and place it in their hand.
-Card* Deck::draw() {
-    if (cards->empty()) {
-        cout << "[Deck::draw] Deck is empty.\n";
-        return nullptr;
-    }
-    uniform_int_distribution<size_t> dist(0, cards->size() - 1);
-    size_t idx = dist(rng());
-    Card* c = (*cards)[idx];
-    (*cards)[idx] = cards->back();
-    cards->pop_back();
-    cout << "[Deck::draw] Drew " << *c << ". Remaining in deck: " << cards->size() << "\n";
-    return c;
+optional<CardType> Deck::draw() {
+    if (cards.empty()) return nullopt;
+    uniform_int_distribution<size_t> dist(0, cards.size() - 1);
+    const size_t idx = dist(rng);
+    const CardType type = cards[idx];
+    cards[idx] = cards.back();
+    cards.pop_back();
+    return type;
 }
 
 //return method: remove a card from a player's hand and
-// returns the card into the deck
-void Deck::returnCard(Card* c) {
-    if (!c) return;
-    cards->push_back(c);
-    cout << "[Deck::returnCard] Returned " << *c << ". Deck size: " << cards->size() << "\n";
+// returns the card into the deck. Cards drawn from this deck fit in the capacity they left behind.
+void Deck::returnCard(CardType type) {
+    cards.push_back(type);
 }
 
-size_t Deck::size() const { return cards->size(); }
+size_t Deck::size() const { return cards.size(); }
 
 //getters for Deck
-const vector<Card*>* Deck::getCards() const { return cards; }
+const vector<CardType>& Deck::getCards() const { return cards; }
+
+uint32_t Deck::getRngState() const {
+    // minstd_rand only exposes its state through the stream operator.
+    stringstream state;
+    state << rng;
+    uint32_t value = 0;
+    state >> value;
+    return value;
+}
+
+void Deck::restore(vector<CardType> order, uint32_t rngState) {
+    cards = std::move(order);
+    rng.seed(rngState);
+}
 
 //stream insertion operator for Deck
 ostream& operator<<(ostream& os, const Deck& d) {
     os << "Deck(size=" << d.size() << ")[";
-    for (size_t i = 0; i < d.cards->size(); ++i) {
-        os << d.cards->at(i)->getType();
-        if (i + 1 < d.cards->size()) os << ", ";
+    for (size_t i = 0; i < d.cards.size(); ++i) {
+        os << CardsUtil::name(d.cards[i]);
+        if (i + 1 < d.cards.size()) os << ", ";
     }
     os << "]";
     return os;
 }
 
-//default constructor for Hand
-Hand::Hand() : cards(new vector<Card*>) {}
-
-//parameterized constructor for Hand
-Hand::Hand(const Hand& other) : cards(new vector<Card*>) {
-    for (const auto* c : *other.cards) {
-        cards->push_back(new Card(*c));
-    }
-}
+static_assert(Hand::MAX_PER_KIND <= UINT8_MAX, "hand counts are one byte per kind");
 
-//assignment operator for Hand
-Hand& Hand::operator=(const Hand& other) {
-    if (this != &other) {
-        for (auto* c : *cards) delete c;
-        cards->clear();
-        for (const auto* c : *other.cards) {
-            cards->push_back(new Card(*c));
-        }
-    }
-    return *this;
-}
-
-//deconstructor for Hand
-Hand::~Hand() {
-    cout << "Destroying hand objects...\n";
-    for (auto* c : *cards) delete c;
-    delete cards;
-}
+//default constructor for Hand
+Hand::Hand() : counts{} {}
 
 //add card into player's hand
-void Hand::addCard(Card* c) { if (c) cards->push_back(c); }
+bool Hand::addCard(CardType type) {
+    uint8_t& held = counts[static_cast<size_t>(type)];
+    if (held == MAX_PER_KIND) return false;
+    ++held;
+    return true;
+}
 
 //remove card from player's hand
-void Hand::removeCard(Card* c) {
-    if (!c) return;
-    auto it = find(cards->begin(), cards->end(), c);
-    if (it != cards->end()) cards->erase(it);
+bool Hand::removeCard(CardType type) {
+    uint8_t& held = counts[static_cast<size_t>(type)];
+    if (held == 0) return false;
+    --held;
+    return true;
 }
 
+//number of cards of one kind in player's hand
+int Hand::count(CardType type) const { return counts[static_cast<size_t>(type)]; }
+
 //number of cards in player's hand
-size_t Hand::size() const { return cards->size(); }
+size_t Hand::size() const {
+    size_t total = 0;
+    for (uint8_t held : counts) total += held;
+    return total;
+}
 
-//getter for cards in player's hand
-const vector<Card*>* Hand::getCards() const { return cards; }
+//getter for cards in player's hand, per kind
+const array<uint8_t, CARD_TYPE_COUNT>& Hand::getCounts() const { return counts; }
 
 //stream insertion operator for Hand
 ostream& operator<<(ostream& os, const Hand& h) {
     os << "Hand(size=" << h.size() << ")[";
-    for (size_t i = 0; i < h.cards->size(); ++i) {
-        os << h.cards->at(i)->getType();
-        if (i + 1 < h.cards->size()) os << ", ";
+    bool first = true;
+    for (int i = 0; i < CARD_TYPE_COUNT; ++i) {
+        for (int n = 0; n < h.counts[static_cast<size_t>(i)]; ++n) {
+            if (!first) os << ", ";
+            os << CardsUtil::name(static_cast<CardType>(i));
+            first = false;
+        }
     }
     os << "]";
     return os;
 }
-
-void testCards() {
-    cout << "=== Part 4: Cards deck/hand demo ===\n";
-
-
-    Deck deck(15);              //set deck size
-    cout << "Deck contents: " << deck << "\n\n";
-
-
-    Player alice("Alice");       //Create a player
-
-
-
-    cout << alice << "\n" << *(alice.getHand()) << "\n\n";
-
-    //Draw 7 cards from the deck and add it to the hand
-    for (int i = 0; i < 7; ++i) {
-        Card* c = deck.draw();
-        if (c) alice.getHand()->addCard(c);
-    }
-
-    cout << "After drawing:\n";
-    cout << "  " << deck << "\n";
-    cout << "  " << alice.getName() <<": "<< *(alice.getHand()) << "\n";
-    cout << "  "<< alice << "\n\n";
-
-    //Play every card in player's hand
-    vector<Card*> toPlay = *alice.getHand()->getCards();
-    for (auto* c : toPlay) {
-        cout << "Playing " << *c << "...\n";
-        c->play(&alice, &deck, alice.getHand());
-    }
-
-    cout << "\nAfter playing all drawn cards:\n";
-    cout << "  " << deck << "\n";
-    cout << "  " << *(alice.getHand()) << "\n";
-    cout << "  " << alice << "\n";
-
-    cout << "=== End of Part 4 demo ===\n";
-}
\ No newline at end of file
@@ -5,7 +5,10 @@
 #ifndef CARDS_H
 #define CARDS_H
 
+#include <array>
+#include <cstdint>
 #include <iostream>
+#include <optional>
 #include <vector>
 #include <string>
 #include <random>
@@ -19,61 +22,104 @@ class Player;
 class Deck;
 class Hand;
 
+// Card kinds. The values index per-kind arrays (Hand counts, snapshot hands and decks).
+enum class CardType : uint8_t {
+    Bomb = 0,
+    Reinforcement,
+    Blockade,
+    Airlift,
+    Diplomacy
+};
+
+constexpr int CARD_TYPE_COUNT = 5;
+
+// What a card is played on, by index: territories into Map::getTerritoryNodes(), players into
+// GameState::getPlayers(). Fields a card kind doesn't use are left at -1 / 0.
+struct CardTarget {
+    int territory = -1;  // bomb, reinforcement and blockade target, airlift destination
+    int source = -1;     // airlift source
+    int armies = 0;      // airlift armies
+    int player = -1;     // diplomacy
+};
+
 class Card {
 public:
-    string* type;
+    CardType type;
+
+    Card(CardType t = CardType::Reinforcement);
+    // Unknown names become reinforcement cards.
+    explicit Card(const string& t);
 
-    Card(const string& t = "reinforcement");
-    Card(const Card& other);
-    Card& operator=(const Card& other);
-    ~Card();
+    CardType getType() const;
+    const char* getName() const;
 
-    const string& getType() const;
+    // Armies a reinforcement card deploys.
+    static constexpr int REINFORCEMENT_ARMIES = 5;
 
-    void play(Player* p, Deck* d, Hand* h);
+    /**
+     * Issues this card's order against the given target in p's game, then moves the card from the
+     * hand back to the deck. Does nothing if the hand holds no such card or the target doesn't fit.
+     * @return Whether the card was played
+     */
+    bool play(Player* p, Deck* d, Hand* h, const CardTarget& target);
+
+    // Plays the card on the target chosen by p's strategy, if it chooses one.
+    bool play(Player* p, Deck* d, Hand* h);
 
     friend ostream& operator<<(ostream& os, const Card& c);
 };
 
 
+// The deck is a flat array of card kinds, one byte per card. Drawing swaps a random card
+// with the last one and pops it, returning pushes it back, and copying is a single memcpy.
+// The deck never logs; callers report draws where a player can see them.
+// Each deck draws from its own small generator, so a seeded deck deals the same cards every game.
 class Deck {
 public:
-    vector<Card*>* cards;
-
     Deck();
     explicit Deck(int size);
-    Deck(const Deck& other);
-    Deck& operator=(const Deck& other);
-    ~Deck();
+    Deck(int size, uint32_t seed);
 
-    Card* draw();
-    void returnCard(Card* c);
+    // Random card, or nothing if the deck is empty.
+    optional<CardType> draw();
+    void returnCard(CardType type);
 
     size_t size() const;
-    const vector<Card*>* getCards() const;
+    const vector<CardType>& getCards() const;
+
+    // Generator state, for checkpoints. restore() puts back the cards in order and the generator,
+    // so the restored deck deals exactly what the saved one would have.
+    uint32_t getRngState() const;
+    void restore(vector<CardType> order, uint32_t rngState);
 
     friend ostream& operator<<(ostream& os, const Deck& d);
 
 private:
-    static mt19937& rng();
+    vector<CardType> cards;
+    minstd_rand rng;
 };
 
 
+// A hand is just how many cards of each kind the player holds, so copying one is copying five bytes.
 class Hand {
 public:
-    vector<Card*>* cards;
-
     Hand();
-    Hand(const Hand& other);
-    Hand& operator=(const Hand& other);
-    ~Hand();
 
-    void addCard(Card* c);
-    void removeCard(Card* c);
+    // Most cards of one kind a hand can hold.
+    static constexpr int MAX_PER_KIND = 255;
+
+    // False, leaving the hand as it was, if it already holds MAX_PER_KIND cards of that kind.
+    bool addCard(CardType type);
+    // False if the hand holds no card of that kind.
+    bool removeCard(CardType type);
+    int count(CardType type) const;
     size_t size() const;
-    const vector<Card*>* getCards() const;
+    const array<uint8_t, CARD_TYPE_COUNT>& getCounts() const;
 
     friend ostream& operator<<(ostream& os, const Hand& h);
+
+private:
+    array<uint8_t, CARD_TYPE_COUNT> counts;
 };
 
 namespace CardsUtil {
@@ -84,12 +130,38 @@ namespace CardsUtil {
         return types;
     }
 
-    inline string normalizeType(const string& t) {
-        for (const auto& s : validTypes()) {
-            if (s == t) return s;
+    inline const char* name(CardType type) {
+        switch (type) {
+            case CardType::Bomb: return "bomb";
+            case CardType::Reinforcement: return "reinforcement";
+            case CardType::Blockade: return "blockade";
+            case CardType::Airlift: return "airlift";
+            case CardType::Diplomacy: return "diplomacy";
         }
         return "reinforcement";
     }
+
+    // Card kind for a name, or false if the name is not a card kind.
+    inline bool parse(const string& t, CardType& type) {
+        for (int i = 0; i < CARD_TYPE_COUNT; ++i) {
+            if (t == name(static_cast<CardType>(i))) {
+                type = static_cast<CardType>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Position of a card type in validTypes(), or -1 if unknown.
+    inline int typeIndex(const string& t) {
+        CardType type;
+        return parse(t, type) ? static_cast<int>(type) : -1;
+    }
+
+    inline string normalizeType(const string& t) {
+        CardType type;
+        return parse(t, type) ? t : "reinforcement";
+    }
 }
 
 void testCards();
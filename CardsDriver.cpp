@@ -1,11 +1,290 @@
 #include "Cards.h"
+#include "SharedDeck.h"
+#include "Player.h"
+#include "PlayerStrategies.h"
+#include "GameState.h"
+#include "Map.h"
+#include "Orders.h"
+#include "DriverCheck.h"
+#include <chrono>
+#include <mutex>
+#include <thread>
 
 using namespace std;
 
+namespace {
+
+// The baseline the shared deck is measured against: the ordinary deck behind one lock.
+class LockedDeck {
+public:
+    explicit LockedDeck(int size) : deck(size) {}
+    optional<CardType> draw() {
+        lock_guard<mutex> lock(guard);
+        return deck.draw();
+    }
+    void returnCard(CardType type) {
+        lock_guard<mutex> lock(guard);
+        deck.returnCard(type);
+    }
+
+private:
+    mutex guard;
+    Deck deck;
+};
+
+// Every thread repeatedly draws a card and puts it back. Returns draw/return pairs per second.
+template <typename D>
+double pairsPerSecond(D& deck, int threads, int pairsPerThread) {
+    vector<thread> workers;
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&deck, pairsPerThread] {
+            for (int i = 0; i < pairsPerThread; ++i) {
+                if (auto card = deck.draw()) deck.returnCard(*card);
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return threads * static_cast<double>(pairsPerThread) / elapsed.count();
+}
+
+}
+
+void testCards() {
+    cout << "=== Part 4: Cards deck/hand demo ===\n";
+
+
+    Deck deck(15);              //set deck size
+    cout << "Deck contents: " << deck << "\n\n";
+
+
+    //A small board so cards have real targets: Alice holds Quebec and Ontario, Bob holds Nunavut
+    Map map("Cards demo", {{"North America", 3}}, {
+        {"Quebec", "North America", {"Ontario"}},
+        {"Ontario", "North America", {"Quebec", "Nunavut"}},
+        {"Nunavut", "North America", {"Ontario"}},
+    });
+    Player alice("Alice");       //Create a player
+    Player bob("Bob");
+    auto& nodes = map.getTerritoryNodes();
+    alice.addTerritory(&nodes[0]);
+    alice.addTerritory(&nodes[1]);
+    bob.addTerritory(&nodes[2]);
+    nodes[0].armies = 8;
+    nodes[1].armies = 2;
+    nodes[2].armies = 6;
+
+    GameState state(&map, {&alice, &bob}, &deck, 1);
+    alice.setGameState(&state);
+    bob.setGameState(&state);
+    alice.setStrategy(new AggressivePlayerStrategy(&alice));
+
+    cout << alice << "\n" << *(alice.getHand()) << "\n\n";
+
+    //Draw 7 cards from the deck and add it to the hand
+    for (int i = 0; i < 7; ++i) {
+        if (auto type = deck.draw()) {
+            alice.getHand()->addCard(*type);
+            cout << "Drew " << CardsUtil::name(*type) << ". Remaining in deck: " << deck.size() << "\n";
+        }
+    }
+
+    cout << "After drawing:\n";
+    cout << "  " << deck << "\n";
+    cout << "  " << alice.getName() <<": "<< *(alice.getHand()) << "\n";
+    cout << "  "<< alice << "\n\n";
+
+    //Play every card in player's hand on the targets Alice's strategy picks
+    for (int i = 0; i < CARD_TYPE_COUNT; ++i) {
+        Card card(static_cast<CardType>(i));
+        while (alice.getHand()->count(card.getType()) > 0) {
+            cout << "Playing " << card << "...\n";
+            if (!card.play(&alice, &deck, alice.getHand())) break;
+        }
+    }
+
+    cout << "\nAfter playing the drawn cards:\n";
+    cout << "  " << deck << "\n";
+    cout << "  " << *(alice.getHand()) << "\n";
+    cout << "  " << alice << "\n";
+    cout << "  " << *alice.getOrdersList() << "\n";
+
+    //Hands count cards per kind, up to 255 of a kind
+    Hand hand;
+    hand.addCard(CardType::Bomb);
+    hand.addCard(CardType::Bomb);
+    hand.addCard(CardType::Airlift);
+    check(hand.count(CardType::Bomb) == 2 && hand.count(CardType::Airlift) == 1 && hand.size() == 3,
+          "a hand counts its cards per kind");
+    check(hand.removeCard(CardType::Bomb) && !hand.removeCard(CardType::Diplomacy) && hand.size() == 2,
+          "removing a card the hand doesn't hold fails and changes nothing");
+    Hand full;
+    bool added = true;
+    for (int i = 0; i < Hand::MAX_PER_KIND; ++i) added = full.addCard(CardType::Blockade) && added;
+    check(added && !full.addCard(CardType::Blockade) && full.count(CardType::Blockade) == Hand::MAX_PER_KIND,
+          "the 256th card of a kind is refused instead of wrapping the count to 0");
+    check(full.addCard(CardType::Bomb) && full.size() == Hand::MAX_PER_KIND + 1u, "other kinds still fit");
+
+    //A conquest card that doesn't fit stays in the deck
+    Player hoarder("Hoarder");
+    for (int i = 0; i < Hand::MAX_PER_KIND; ++i) {
+        for (int kind = 0; kind < CARD_TYPE_COUNT; ++kind) hoarder.addCard(static_cast<CardType>(kind));
+    }
+    Deck spare(5, 345);
+    GameState hoard(&map, {&hoarder}, &spare, 1);
+    hoard.awardConquestCard(&hoarder);
+    check(spare.size() == 5 && hoarder.getHand()->size() == CARD_TYPE_COUNT * size_t(Hand::MAX_PER_KIND),
+          "a conquest card the full hand can't take goes back to the deck");
+
+    //Drawing and returning every card keeps each kind, and a seeded deck deals the same cards
+    Deck counted(50, 345);
+    auto kinds = [](const vector<CardType>& cards) {
+        array<int, CARD_TYPE_COUNT> perKind{};
+        for (CardType type : cards) ++perKind[static_cast<size_t>(type)];
+        return perKind;
+    };
+    const auto dealt = kinds(counted.getCards());
+    check(dealt == array<int, CARD_TYPE_COUNT>{10, 10, 10, 10, 10}, "a 50-card deck holds ten of each kind");
+    vector<CardType> drawn;
+    while (auto type = counted.draw()) drawn.push_back(*type);
+    check(drawn.size() == 50 && counted.size() == 0 && !counted.draw(), "the deck deals every card once, then nothing");
+    check(kinds(drawn) == dealt, "the cards drawn are the cards the deck held, kind for kind");
+    for (CardType type : drawn) counted.returnCard(type);
+    check(counted.size() == 50 && kinds(counted.getCards()) == dealt, "returning them restores the deck's kinds");
+
+    Deck first(30, 7), second(30, 7);
+    bool same = true;
+    for (int i = 0; i < 30; ++i) same = first.draw() == second.draw() && same;
+    check(same, "two decks with the same seed deal the same cards");
+
+    Deck original(30, 9);
+    original.draw();
+    Deck copy(0, 1);
+    copy.restore(original.getCards(), original.getRngState());
+    same = true;
+    for (int i = 0; i < 29; ++i) same = original.draw() == copy.draw() && same;
+    check(same, "a deck restored from another's cards and generator deals what it would have");
+
+    //Each card becomes its order on the target the strategy picks, and goes back to the deck.
+    //Carol's Quebec is pressed by Dave's Ontario and Eve's Nunavut; her Manitoba is safe behind it.
+    Map front("Cards targets", {{"Canada", 3}}, {
+        {"Quebec", "Canada", {"Ontario", "Nunavut", "Manitoba"}},
+        {"Ontario", "Canada", {"Quebec"}},
+        {"Nunavut", "Canada", {"Quebec"}},
+        {"Manitoba", "Canada", {"Quebec"}},
+    });
+    Player carol("Carol"), dave("Dave"), eve("Eve");
+    auto& lines = front.getTerritoryNodes();
+    carol.addTerritory(&lines[0]);
+    dave.addTerritory(&lines[1]);
+    eve.addTerritory(&lines[2]);
+    carol.addTerritory(&lines[3]);
+    lines[0].armies = 1;
+    lines[1].armies = 10;
+    lines[2].armies = 4;
+    lines[3].armies = 9;
+    Deck pile(0, 1);
+    GameState board(&front, {&carol, &dave, &eve}, &pile, 1);
+    for (Player* p : {&carol, &dave, &eve}) p->setGameState(&board);
+    carol.setStrategy(new AggressivePlayerStrategy(&carol));
+
+    auto playOne = [&](CardType type) -> Order* {
+        carol.getHand()->addCard(type);
+        const int before = pile.size();
+        const bool played = Card(type).play(&carol, &pile, carol.getHand());
+        const bool returned = pile.size() == before + 1 && pile.getCards().back() == type;
+        const OrdersList* orders = carol.getOrdersList();
+        if (!played || !returned || carol.getHand()->count(type) != 0 || orders->empty()) return nullptr;
+        return orders->getOrder(orders->size() - 1);
+    };
+    auto* bomb = dynamic_cast<Bomb*>(playOne(CardType::Bomb));
+    check(bomb && bomb->getTargetTerritory() == "Ontario", "a bomb card bombs the strongest enemy neighbour and goes back to the deck");
+    auto* reinforcement = dynamic_cast<Deploy*>(playOne(CardType::Reinforcement));
+    check(reinforcement && reinforcement->getTargetTerritory() == "Quebec", "a reinforcement card deploys on the territory under most pressure");
+    auto* airlift = dynamic_cast<Airlift*>(playOne(CardType::Airlift));
+    check(airlift && airlift->getSourceTerritory() == "Manitoba" && airlift->getTargetTerritory() == "Quebec" &&
+          airlift->getArmyUnits() == 8, "an airlift card flies all but one army from the safe reserve to the front");
+    auto* diplomacy = dynamic_cast<Negotiate*>(playOne(CardType::Diplomacy));
+    check(diplomacy && diplomacy->getTargetPlayer() == "Dave", "a diplomacy card negotiates with the player with most armies on the border");
+    auto* blockade = dynamic_cast<Blockade*>(playOne(CardType::Blockade));
+    check(blockade && blockade->getTargetTerritory() == "Quebec", "a blockade card blockades the territory that would fall anyway");
+    check(pile.size() == CARD_TYPE_COUNT, "every played card is back in the deck");
+
+    //A blockade hands the territory to a Neutral player, created once and reused after that
+    board.apply(blockade);
+    Player* neutral = lines[0].owner;
+    check(neutral && neutral != &carol && dynamic_cast<NeutralPlayerStrategy*>(neutral->getStrategy()) &&
+          lines[0].armies == 3 && board.getPlayers().size() == 4 && board.playerId(neutral) == 3,
+          "a blockaded territory goes to a new Neutral player with its armies tripled");
+    check(board.snapshot().getOwner(0) == 3, "the snapshot sees the Neutral player as the owner");
+    carol.issueOrder(new Blockade("Manitoba"));
+    board.apply(carol.getOrdersList()->getOrder(carol.getOrdersList()->size() - 1));
+    auto joined = board.takeJoinedPlayers();
+    check(lines[3].owner == neutral && board.getPlayers().size() == 4 && joined.size() == 1 && joined[0].get() == neutral &&
+          board.takeJoinedPlayers().empty(), "a second blockade reuses the Neutral player, adopted once");
+
+    cout << "=== End of Part 4 demo ===\n";
+}
+
+void testSharedDeck() {
+    cout << "=== Shared Deck Demo ===\n";
+
+    // Stress: tables hold on to a few cards at a time, so shards run dry and threads steal from
+    // each other's. Afterwards every card must be back, no more and no fewer of each kind.
+    const int threads = static_cast<int>(max(4u, thread::hardware_concurrency()));
+    SharedDeck shared(100, static_cast<size_t>(threads));
+    array<size_t, CARD_TYPE_COUNT> before{};
+    for (int i = 0; i < CARD_TYPE_COUNT; ++i) before[i] = shared.count(static_cast<CardType>(i));
+
+    vector<thread> tables;
+    for (int t = 0; t < threads; ++t) {
+        tables.emplace_back([&shared, t] {
+            Hand hand;
+            for (int i = 0; i < 200000; ++i) {
+                if (hand.size() < 5 && (i + t) % 3 != 0) {
+                    if (auto card = shared.draw()) hand.addCard(*card);
+                } else {
+                    for (int kind = 0; kind < CARD_TYPE_COUNT; ++kind) {
+                        if (hand.removeCard(static_cast<CardType>(kind))) {
+                            shared.returnCard(static_cast<CardType>(kind));
+                            break;
+                        }
+                    }
+                }
+            }
+            for (int kind = 0; kind < CARD_TYPE_COUNT; ++kind) {
+                while (hand.removeCard(static_cast<CardType>(kind))) shared.returnCard(static_cast<CardType>(kind));
+            }
+        });
+    }
+    for (auto& table : tables) table.join();
+
+    bool conserved = true;
+    for (int i = 0; i < CARD_TYPE_COUNT; ++i) {
+        conserved = conserved && shared.count(static_cast<CardType>(i)) == before[i];
+    }
+    cout << threads << " tables x 200000 operations on " << shared.shardCount() << " shards: "
+         << shared.size() << " cards left, every kind accounted for: " << (conserved ? "yes" : "NO") << "\n";
+
+    // Throughput against the locked deck.
+    cout << "Draw/return pairs per second:\n";
+    for (int n : {1, 2, 4, 8}) {
+        LockedDeck locked(100);
+        SharedDeck lockFree(100);
+        const double lockedRate = pairsPerSecond(locked, n, 100000);
+        const double sharedRate = pairsPerSecond(lockFree, n, 100000);
+        cout << "  " << n << " thread(s): locked Deck " << static_cast<long long>(lockedRate)
+             << ", SharedDeck " << static_cast<long long>(sharedRate) << " (x" << sharedRate / lockedRate << ")\n";
+    }
+
+    cout << "=== End of Shared Deck Demo ===\n";
+}
+
 /**
 int main() {
     testCards();
+    testSharedDeck();
     return 0;
 }
  */
-
@@ -2,25 +2,105 @@
 // Command processing classes for the game engine.
 
 #include "CommandProcessing.h"
-#include <algorithm>
+#include "BinaryIO.h"
 #include <cctype>
+#include <chrono>
+#include <thread>
 #include <string>
 #include <vector>
 using namespace std;
 
 namespace {
 
-string trim(const string& value)
+bool isBlank(char c)
 {
-    size_t first = value.find_first_not_of(" \t\r\n");
-    if (first == string::npos)
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+string_view trim(string_view value)
+{
+    while (!value.empty() && isBlank(value.front())) value.remove_prefix(1);
+    while (!value.empty() && isBlank(value.back())) value.remove_suffix(1);
+    return value;
+}
+
+char lower(char c)
+{
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+// Perfect hash over the eight keywords: four times the length plus the first letter, modulo 16,
+// lands each in its own slot.
+constexpr size_t KEYWORD_SLOTS = 16;
+constexpr CommandTypes ALL_COMMANDS[] = {LoadMap, ValidateMap, AddPlayer, GameStart, Replay, Quit,
+                                         EndIssueOrders, EndExecOrders};
+
+constexpr size_t keywordSlot(size_t length, char first)
+{
+    return (4 * length + static_cast<unsigned char>(first)) % KEYWORD_SLOTS;
+}
+
+constexpr string_view KEYWORDS[] = {"loadmap", "validatemap", "addplayer", "gamestart", "replay", "quit",
+                                    "endissueorders", "endexecorders"};
+
+struct KeywordTable
+{
+    int command[KEYWORD_SLOTS];  // index into ALL_COMMANDS, -1 for an empty slot
+    bool perfect;
+
+    constexpr KeywordTable() : command{}, perfect(true)
     {
-        return "";
+        for (int& slot : command) slot = -1;
+        for (int i = 0; i < static_cast<int>(sizeof(KEYWORDS) / sizeof(KEYWORDS[0])); ++i)
+        {
+            int& slot = command[keywordSlot(KEYWORDS[i].size(), KEYWORDS[i][0])];
+            if (slot != -1) perfect = false;
+            slot = i;
+        }
     }
-    size_t last = value.find_last_not_of(" \t\r\n");
-    return value.substr(first, last - first + 1);
+};
+
+constexpr KeywordTable KEYWORD_TABLE{};
+static_assert(KEYWORD_TABLE.perfect, "two keywords share a slot, change keywordSlot()");
+
 }
 
+CommandToken CommandParsing::tokenize(string_view line)
+{
+    line = trim(line);
+    CommandToken token;
+    const size_t space = line.find_first_of(" \t");
+    token.keyword = line.substr(0, space);
+    if (space != string_view::npos)
+    {
+        token.parameter = trim(line.substr(space + 1));
+    }
+    return token;
+}
+
+bool CommandParsing::lookup(string_view word, CommandTypes& type)
+{
+    if (word.empty()) return false;
+    const int index = KEYWORD_TABLE.command[keywordSlot(word.size(), lower(word[0]))];
+    if (index < 0) return false;
+    // Other lengths can land in the same slot, e.g. a 20-character word starting with 'q'.
+    const string_view candidate = KEYWORDS[index];
+    if (word.size() != candidate.size()) return false;
+    for (size_t i = 0; i < word.size(); ++i)
+    {
+        if (lower(word[i]) != candidate[i]) return false;
+    }
+    type = ALL_COMMANDS[index];
+    return true;
+}
+
+const char* CommandParsing::keyword(CommandTypes type)
+{
+    for (size_t i = 0; i < sizeof(ALL_COMMANDS) / sizeof(ALL_COMMANDS[0]); ++i)
+    {
+        if (ALL_COMMANDS[i] == type) return KEYWORDS[i].data();  // literals, so null-terminated
+    }
+    return "";
 }
 
 // Default Command constructor.
@@ -59,6 +139,13 @@ Command& Command::operator=(const Command& other)
     return *this;
 }
 
+void Command::set(CommandTypes type, string_view parameter, State effect)
+{
+    this->type = type;
+    this->parameter.assign(parameter.data(), parameter.size());
+    this->effect = effect;
+}
+
 ostream& operator<<(ostream& os, const Command& cmd)
 {
     os << "Command Type: ";
@@ -82,6 +169,12 @@ ostream& operator<<(ostream& os, const Command& cmd)
     case Quit:
         os << "Quit";
         break;
+    case EndIssueOrders:
+        os << "EndIssueOrders";
+        break;
+    case EndExecOrders:
+        os << "EndExecOrders";
+        break;
     default:
         os << "Unknown";
         break;
@@ -93,37 +186,27 @@ ostream& operator<<(ostream& os, const Command& cmd)
 
 CommandProcessor::CommandProcessor()
 {
-    commands = {};
     currentState = State::Start;
 }
 
 CommandProcessor::CommandProcessor(const CommandProcessor& other)
 {
     currentState = other.currentState;
-    // Deep copy of commands
-    for (Command* cmd : other.commands)
-    {
-        commands.push_back(new Command(*cmd));
-    }
+    current = other.current;
+    history = other.history;
+    historyLimit = other.historyLimit;
+    historyNext = other.historyNext;
 }
 
 CommandProcessor& CommandProcessor::operator=(const CommandProcessor& other)
 {
     if (this != &other)
     {
-        // Clean up existing commands
-        for (Command* cmd : commands)
-        {
-            delete cmd;
-        }
-        commands.clear();
-
         currentState = other.currentState;
-        // Deep copy of commands
-        for (Command* cmd : other.commands)
-        {
-            commands.push_back(new Command(*cmd));
-        }
+        current = other.current;
+        history = other.history;
+        historyLimit = other.historyLimit;
+        historyNext = other.historyNext;
     }
     return *this;
 }
@@ -132,20 +215,16 @@ ostream& operator<<(ostream& os, const CommandProcessor& cp)
 {
     os << "CommandProcessor State: " << GameEngine::name(cp.currentState) << endl;
     os << "Commands:" << endl;
-    for (const Command* cmd : cp.commands)
+    // Oldest first.
+    for (size_t i = 0; i < cp.history.size(); ++i)
     {
-        os << *cmd << endl;
+        os << cp.history[(cp.historyNext + i) % cp.history.size()] << endl;
     }
     return os;
 }
 
 CommandProcessor::~CommandProcessor()
 {
-    // Clean up allocated Command objects.
-    for (Command* cmd : commands)
-    {
-        delete cmd;
-    }
 }
 
 // Try to read a command until successful.
@@ -154,29 +233,18 @@ Command* CommandProcessor::getCommand()
     bool validCommand = false;
     while (!validCommand)
     {
-        string* inputs = readCommand();
+        if (!hasMoreCommands()) {
+            return nullptr;
+        }
+        const CommandToken token = readCommand();
+        // A source can run out while reading, e.g. a queue closed while the game waited on it.
+        if (token.keyword.empty() && !hasMoreCommands()) {
+            return nullptr;
+        }
 
         // Find the command type.
         CommandTypes commandType;
-        if (inputs[0] == "loadmap") {
-            commandType = LoadMap;
-        }
-        else if (inputs[0] == "validatemap") {
-            commandType = ValidateMap;
-        }
-        else if (inputs[0] == "addplayer") {
-            commandType = AddPlayer;
-        }
-        else if (inputs[0] == "gamestart") {
-            commandType = GameStart;
-        }
-        else if (inputs[0] == "replay") {
-            commandType = Replay;
-        }
-        else if (inputs[0] == "quit") {
-            commandType = Quit;
-        }
-        else {
+        if (!CommandParsing::lookup(token.keyword, commandType)) {
             cout << "Invalid command entered." << endl;
             continue;
         }
@@ -189,13 +257,13 @@ Command* CommandProcessor::getCommand()
 
         // Only some commands require parameters.
         if (commandType == LoadMap || commandType == AddPlayer) {
-            if (inputs[1].empty()) {
+            if (token.parameter.empty()) {
                 cout << "Command requires a parameter." << endl;
                 continue;
             }
         }
         else {
-            if (!inputs[1].empty()) {
+            if (!token.parameter.empty()) {
                 cout << "Command does not take a parameter. Ignoring." << endl;
             }
         }
@@ -221,18 +289,23 @@ Command* CommandProcessor::getCommand()
         case Quit:
             effect = State::Finished;
             break;
+        case EndIssueOrders:
+            effect = State::ExecuteOrders;
+            break;
+        case EndExecOrders:
+            effect = State::AssignReinforcement;
+            break;
         default:
             effect = currentState; // No state change for unknown commands.
             break;
         }
 
-        Command* command = new Command(commandType, inputs[1], effect);
-
-        saveCommand(command);
+        current.set(commandType, token.parameter, effect);
+        saveCommand(current);
         validCommand = true;
     }
 
-    return commands.back();
+    return &current;
 }
 
 void CommandProcessor::setState(State state)
@@ -240,34 +313,49 @@ void CommandProcessor::setState(State state)
     currentState = state;
 }
 
-string* CommandProcessor::readCommand()
+CommandToken CommandProcessor::readCommand()
 {
     // Take a user input command from console.
     cout << "Enter command: ";
-    string input;
-    getline(cin, input);
-
-    static string inputs[2];
+    getline(cin, line);
+    return CommandParsing::tokenize(line);
+}
 
-    size_t spacePos = input.find_first_of(" \t");
-    if (spacePos != string::npos) {
-        inputs[0] = input.substr(0, spacePos);
-        inputs[1] = trim(input.substr(spacePos + 1));
+// Save a command to the history and the journal.
+void CommandProcessor::saveCommand(const Command& command)
+{
+    if (history.size() < historyLimit)
+    {
+        history.push_back(command);
     }
-    else {
-        inputs[0] = input;
-        inputs[1] = "";
+    else if (historyLimit > 0)
+    {
+        // Assigning over the oldest entry reuses its parameter's storage.
+        history[historyNext] = command;
+        historyNext = (historyNext + 1) % history.size();
+    }
+    if (journal)
+    {
+        JournalRecord record;
+        record.type = JournalRecordType::Command;
+        record.kind = command.getType();
+        record.first = command.getParameter();
+        journal->append(record);
     }
-
-    std::transform(inputs[0].begin(), inputs[0].end(), inputs[0].begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-
-    return inputs;
 }
 
-// Save a command to the list.
-void CommandProcessor::saveCommand(Command* command)
+void CommandProcessor::setHistoryLimit(size_t limit)
 {
-    commands.push_back(command);
+    // Keep the newest ones that still fit, oldest first.
+    vector<Command> kept;
+    const size_t count = history.size();
+    for (size_t i = count > limit ? count - limit : 0; i < count; ++i)
+    {
+        kept.push_back(history[(historyNext + i) % count]);
+    }
+    history = std::move(kept);
+    historyLimit = limit;
+    historyNext = 0;
 }
 
 // Validate if a command is allowed in the current state.
@@ -293,6 +381,12 @@ bool CommandProcessor::validateCommand(CommandTypes commandType)
     case Quit:
         validInState = (currentState == State::Win);
         break;
+    case EndIssueOrders:
+        validInState = (currentState == State::IssueOrders);
+        break;
+    case EndExecOrders:
+        validInState = (currentState == State::ExecuteOrders);
+        break;
     }
     return validInState;
 }
@@ -321,31 +415,126 @@ FileCommandProcessorAdapter::~FileCommandProcessorAdapter()
 }
 
 // Read a command from the file.
-string* FileCommandProcessorAdapter::readCommand()
+CommandToken FileCommandProcessorAdapter::readCommand()
 {
-    static string inputs[2];
-
     if (!inputFile.is_open() || inputFile.eof()) {
         cout << "Command file is not open or has reached EOF." << endl;
         throw runtime_error("Command file is not open or has reached EOF.");
     }
 
-    string line;
     getline(inputFile, line);
+    const CommandToken token = CommandParsing::tokenize(line);
 
-    size_t spacePos = line.find_first_of(" \t");
-    if (spacePos != string::npos) {
-        inputs[0] = line.substr(0, spacePos);
-        inputs[1] = trim(line.substr(spacePos + 1));
+    cout << "Read command from file: " << token.keyword << " " << token.parameter << endl;
+
+    return token;
+}
+
+BatchFileCommandProcessor::BatchFileCommandProcessor(const string& filepath) : filePath(filepath)
+{
+    // Regression scripts run to many thousands of lines; nobody prints their history.
+    setHistoryLimit(0);
+    if (!readFileBytes(filepath, text)) {
+        throw runtime_error("Could not open command file: " + filepath);
     }
-    else {
-        inputs[0] = line;
-        inputs[1] = "";
+    if (text.size() > UINT32_MAX) {
+        throw runtime_error("Command file is too large: " + filepath);
     }
 
-    std::transform(inputs[0].begin(), inputs[0].end(), inputs[0].begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    // Lines are about as long as a command, so a rough count keeps the array from regrowing.
+    lines.reserve(text.size() / 12 + 1);
+    const char* begin = text.data();
+    const string_view all(begin, text.size());
+    size_t start = 0;
+    while (start < all.size()) {
+        size_t end = all.find('\n', start);
+        if (end == string_view::npos) end = all.size();
+        const CommandToken token = CommandParsing::tokenize(all.substr(start, end - start));
+        if (!token.keyword.empty()) {
+            Line line;
+            line.keyword = static_cast<uint32_t>(token.keyword.data() - begin);
+            line.keywordLength = static_cast<uint32_t>(token.keyword.size());
+            line.parameter = static_cast<uint32_t>(token.parameter.empty() ? 0 : token.parameter.data() - begin);
+            line.parameterLength = static_cast<uint32_t>(token.parameter.size());
+            lines.push_back(line);
+        }
+        start = end + 1;
+    }
+}
 
-    cout << "Read command from file: " << inputs[0] << " " << inputs[1] << endl;
+// Serve the next pre-tokenized command.
+CommandToken BatchFileCommandProcessor::readCommand()
+{
+    const Line& line = lines[next++];
+    const char* begin = text.data();
+    return CommandToken{string_view(begin + line.keyword, line.keywordLength),
+                        string_view(begin + line.parameter, line.parameterLength)};
+}
 
-    return inputs;
-}
\ No newline at end of file
+JournalCommandProcessor::JournalCommandProcessor(const vector<JournalRecord>& records)
+{
+    for (const JournalRecord& record : records)
+    {
+        if (record.type == JournalRecordType::Command)
+        {
+            pending.push_back(&record);
+        }
+    }
+}
+
+// Read the next journaled command.
+CommandToken JournalCommandProcessor::readCommand()
+{
+    if (next >= pending.size()) {
+        throw runtime_error("Journal has no more commands.");
+    }
+    const JournalRecord& record = *pending[next++];
+    return CommandToken{CommandParsing::keyword(static_cast<CommandTypes>(record.kind)), record.first};
+}
+
+
+QueueCommandProcessor::QueueCommandProcessor(size_t capacity) : queue(capacity)
+{
+}
+
+bool QueueCommandProcessor::push(string_view commandLine)
+{
+    if (closed.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    return queue.tryPush(commandLine);
+}
+
+void QueueCommandProcessor::close()
+{
+    closed.store(true, std::memory_order_release);
+}
+
+bool QueueCommandProcessor::hasMoreCommands() const
+{
+    // Everything pushed before close() is visible once closed is.
+    return !closed.load(std::memory_order_acquire) || !queue.empty();
+}
+
+// Read the next queued command.
+CommandToken QueueCommandProcessor::readCommand()
+{
+    for (int attempt = 0; ; ++attempt) {
+        if (queue.tryPop(line)) {
+            return CommandParsing::tokenize(line);
+        }
+        // Everything pushed before close() is visible once closed is, so look one last time.
+        if (closed.load(std::memory_order_acquire)) {
+            if (queue.tryPop(line)) {
+                return CommandParsing::tokenize(line);
+            }
+            return CommandToken{};
+        }
+        if (attempt < 64) {
+            std::this_thread::yield();
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+}
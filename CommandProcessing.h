@@ -5,12 +5,17 @@
 #define COMP345_RISK_COMMANDPROCESSING_H
 
 #include "GameEngine.h"
+#include "Journal.h"
+#include "SpscQueue.h"
+#include <atomic>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <fstream>
 using namespace std;
 
-// Commands used to progress the game engine.
+// Commands used to progress the game engine. Journals store these values, so new ones go at the end.
 enum CommandTypes
 {
     LoadMap,
@@ -18,9 +23,32 @@ enum CommandTypes
     AddPlayer,
     GameStart,
     Replay,
-    Quit
+    Quit,
+    EndIssueOrders,
+    EndExecOrders
 };
 
+// One input line split into its keyword and the rest, both trimmed. The views point into the line,
+// so a token is only valid until the processor that made it reads the next line.
+struct CommandToken
+{
+    string_view keyword;
+    string_view parameter;
+};
+
+namespace CommandParsing
+{
+    // Splits a line at the first space or tab. Never allocates.
+    CommandToken tokenize(string_view line);
+
+    // Command type for a keyword in any letter case, or false if it names no command. A perfect hash
+    // picks the only keyword that could match, so this is one table lookup and one comparison.
+    bool lookup(string_view keyword, CommandTypes& type);
+
+    // The word typed for a command type.
+    const char* keyword(CommandTypes type);
+}
+
 // Stores a command object. Its type, the commands it leads to, and if it requires an additional parameter.
 class Command
 {
@@ -30,7 +58,9 @@ class Command
         Command(const Command& other);
         Command& operator=(const Command& other);
         friend ostream& operator<<(ostream& os, const Command& cmd);
-        string getParameter() const { return parameter; }
+        // Overwrites this command in place, reusing the parameter's storage.
+        void set(CommandTypes type, string_view parameter, State effect);
+        const string& getParameter() const { return parameter; }
         State getEffect() const { return effect; }
         CommandTypes getType() const { return type; }
     private:
@@ -39,6 +69,8 @@ class Command
         State effect;
 };
 
+// Reads commands for one game. Every processor keeps its input in its own members, so processors
+// for different games can run on different threads; the console one reads the shared std::cin.
 class CommandProcessor
 {
     public:
@@ -47,14 +79,33 @@ class CommandProcessor
         CommandProcessor& operator=(const CommandProcessor& other);
         friend ostream& operator<<(ostream& os, const CommandProcessor& cp);
         virtual ~CommandProcessor();
+        // Next valid command, or nullptr once hasMoreCommands() turns false. The command belongs to the
+        // processor and is overwritten by the next call, so reading commands allocates nothing once the
+        // parameter's storage has grown to fit.
         Command* getCommand();
+        // False once a finite source has served its last command. Sources that throw at their end
+        // instead, or never end, always return true.
+        virtual bool hasMoreCommands() const { return true; }
         void setState(State state);
         State getState() const { return currentState; }
+        // Every command accepted from now on is also appended to the journal (nullptr to stop).
+        void setJournal(JournalWriter* journal) { this->journal = journal; }
+        // How many of the latest commands are kept for printing; 0 keeps none. Older ones are dropped.
+        void setHistoryLimit(size_t limit);
+        size_t getHistoryLimit() const { return historyLimit; }
+        static constexpr size_t DEFAULT_HISTORY = 64;
     protected:
-        virtual string* readCommand();
-        void saveCommand(Command* command);
+        // Next line of input as a token viewing into this processor's own buffer.
+        virtual CommandToken readCommand();
+        void saveCommand(const Command& command);
     private:
-        vector<Command*> commands;
+        Command current;
+        // Ring of the latest commands; once full, the oldest is at historyNext and is overwritten next.
+        vector<Command> history;
+        size_t historyLimit = DEFAULT_HISTORY;
+        size_t historyNext = 0;
+        string line;
+        JournalWriter* journal = nullptr;
         State currentState;
         bool validateCommand(CommandTypes commandType);
 };
@@ -68,10 +119,82 @@ class FileCommandProcessorAdapter : public CommandProcessor
         friend ostream& operator<<(ostream& os, const FileCommandProcessorAdapter& fcp);
         ~FileCommandProcessorAdapter() override;
     protected:
-        string* readCommand() override;
+        CommandToken readCommand() override;
     private:
         string filePath;
         std::ifstream inputFile;
+        string line;
+};
+
+// Batch mode for long regression scripts: the whole file is read with a single read and split into
+// a compact array of (offset, length) pairs up front, so getCommand() never touches the file, never
+// echoes, and returns nullptr at the end of the script instead of throwing. Blank lines are skipped.
+// Commands are served in the processor's one reused Command, and no history is kept.
+class BatchFileCommandProcessor : public CommandProcessor
+{
+    public:
+        // Throws std::runtime_error if the file can't be read.
+        explicit BatchFileCommandProcessor(const string& filepath);
+        BatchFileCommandProcessor(const BatchFileCommandProcessor& other) = delete;
+        BatchFileCommandProcessor& operator=(const BatchFileCommandProcessor& other) = delete;
+
+        bool hasMoreCommands() const override { return next < lines.size(); }
+        size_t commandCount() const { return lines.size(); }
+    protected:
+        CommandToken readCommand() override;
+    private:
+        // One pre-tokenized line, as offsets into text.
+        struct Line
+        {
+            uint32_t keyword;
+            uint32_t keywordLength;
+            uint32_t parameter;
+            uint32_t parameterLength;
+        };
+
+        string filePath;
+        vector<char> text;
+        vector<Line> lines;
+        size_t next = 0;
+};
+
+// Serves the commands recorded in a journal, in order, for replays. Throws once they run out.
+class JournalCommandProcessor : public CommandProcessor
+{
+    public:
+        explicit JournalCommandProcessor(const vector<JournalRecord>& records);
+    protected:
+        CommandToken readCommand() override;
+    private:
+        vector<const JournalRecord*> pending;
+        size_t next = 0;
+};
+
+// Serves commands pushed from another thread, e.g. a network or scheduler thread feeding one game
+// hosted among many in the process. One thread pushes and the game's thread reads, through a
+// lock-free SPSC queue, so neither side ever blocks the other.
+class QueueCommandProcessor : public CommandProcessor
+{
+    public:
+        explicit QueueCommandProcessor(size_t capacity = 256);
+        QueueCommandProcessor(const QueueCommandProcessor& other) = delete;
+        QueueCommandProcessor& operator=(const QueueCommandProcessor& other) = delete;
+
+        // Producer thread only. Queues one command line; false if the queue is full or closed.
+        bool push(string_view commandLine);
+        // Producer thread only. No more commands: getCommand() returns nullptr once the queued ones are used up.
+        void close();
+
+        // Consumer thread only. False once the queue is closed and drained.
+        bool hasMoreCommands() const override;
+    protected:
+        // Waits for the next command, spinning briefly and then backing off to short sleeps. Returns an
+        // empty token if the queue is closed while waiting.
+        CommandToken readCommand() override;
+    private:
+        SpscQueue<string> queue;
+        std::atomic<bool> closed{false};
+        string line;
 };
 
 #endif
\ No newline at end of file
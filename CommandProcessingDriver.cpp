@@ -1,12 +1,18 @@
 #include "CommandProcessingDriver.h"
 #include "CommandProcessing.h"
 #include "GameEngine.h"
+#include "DriverCheck.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
 
 // Free function.
 void testCommandProcessor(int argc, char* argv[])
 {
-    // Read through the arguments. Either -console or -file <filename> is expected.
+    // Read through the arguments. Either -console, -file <filename>, -batch <filename> or -queue is expected.
     std::unique_ptr<CommandProcessor> cp;
+    std::thread producer;
 
     if (argc > 1)
     {
@@ -17,39 +23,244 @@ void testCommandProcessor(int argc, char* argv[])
             FileCommandProcessorAdapter fileCp(filename);
             cp = std::make_unique<FileCommandProcessorAdapter>(filename);
         }
+        else if (mode == "-batch" && argc > 2)
+        {
+            cp = std::make_unique<BatchFileCommandProcessor>(argv[2]);
+        }
         else if (mode == "-console")
         {
             CommandProcessor consoleCp;
             cp = std::make_unique<CommandProcessor>();
         }
+        else if (mode == "-queue")
+        {
+            // Another thread feeds the commands, as a network thread would for a hosted game.
+            auto queueCp = std::make_unique<QueueCommandProcessor>(8);
+            QueueCommandProcessor* queue = queueCp.get();
+            producer = std::thread([queue]() {
+                const char* script[] = {"loadmap Americas 1792.map", "validatemap", "addplayer Ann",
+                                        "addplayer Bo", "gamestart", "quit"};
+                for (const char* line : script)
+                {
+                    while (!queue->push(line))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                queue->close();
+            });
+            cp = std::move(queueCp);
+        }
         else
         {
-            cout << "Invalid arguments. Usage: <program> [-console | -file <filename>]" << endl;
+            cout << "Invalid arguments. Usage: <program> [-console | -file <filename> | -batch <filename> | -queue]" << endl;
             return;
         }
     }
     else
     {
-        cout << "Invalid arguments. Usage: <program> [-console | -file <filename>]" << endl;
+        cout << "Invalid arguments. Usage: <program> [-console | -file <filename> | -batch <filename> | -queue]" << endl;
         return;
     }
 
     State currentState = State::Start;
     cp->setState(currentState);
     cout << "Initial State: " << GameEngine::name(cp->getState()) << endl;
-    while (currentState != State::Finished)
+    // The file and console sources throw when their input ends; the producer must still be joined.
+    try
     {
-        Command* cmd = cp->getCommand();
-        currentState = cmd->getEffect();
-        if (currentState == State::AssignReinforcement)
+        while (currentState != State::Finished)
         {
-            currentState = State::Win; // Skip to Win for testing.
+            Command* cmd = cp->getCommand();
+            if (!cmd)
+            {
+                cout << "No more commands." << endl;
+                break;
+            }
+            currentState = cmd->getEffect();
+            if (currentState == State::AssignReinforcement)
+            {
+                currentState = State::Win; // Skip to Win for testing.
+            }
+            cp->setState(currentState);
+            cout << "Saved Command: " << *cmd << endl;
+            cout << "Current State updated to: " << GameEngine::name(cp->getState()) << endl;
         }
-        cp->setState(currentState);
-        cout << "Saved Command: " << *cmd << endl;
-        cout << "Current State updated to: " << GameEngine::name(cp->getState()) << endl;
+    }
+    catch (const std::exception& e)
+    {
+        cout << "Command processing terminated: " << e.what() << endl;
     }
 
     cout << "Final State reached. Summary of commands:" << endl;
     cout << *cp << endl;
-}
\ No newline at end of file
+    if (producer.joinable())
+    {
+        producer.join();
+    }
+}
+
+void testCommandParsing()
+{
+    cout << "=== Command Parsing Driver ===" << endl;
+
+    CommandToken token = CommandParsing::tokenize("  AddPlayer \t Ann  Lee \r");
+    check(token.keyword == "AddPlayer" && token.parameter == "Ann  Lee", "keyword and parameter are trimmed, inner spaces kept");
+    token = CommandParsing::tokenize("gamestart");
+    check(token.keyword == "gamestart" && token.parameter.empty(), "a bare keyword has an empty parameter");
+    token = CommandParsing::tokenize(" \t \r");
+    check(token.keyword.empty() && token.parameter.empty(), "a blank line gives an empty token");
+
+    CommandTypes type;
+    bool allFound = true;
+    for (int i = LoadMap; i <= EndExecOrders; ++i)
+    {
+        const CommandTypes expected = static_cast<CommandTypes>(i);
+        allFound = allFound && CommandParsing::lookup(CommandParsing::keyword(expected), type) && type == expected;
+    }
+    check(allFound, "every keyword looks up its own command type");
+    check(CommandParsing::lookup("LoadMap", type) && type == LoadMap && CommandParsing::lookup("VALIDATEMAP", type) &&
+              type == ValidateMap && CommandParsing::lookup("qUiT", type) && type == Quit,
+          "lookup ignores letter case");
+
+    bool anyFound = false;
+    for (string_view word : {string_view(""), string_view("load"), string_view("loadmaps"), string_view("gamestar"),
+                             string_view("xquit"), string_view("quiz"), string_view("replay\0", 7),
+                             string_view("qui\0t", 5), string_view("l\xc3\xb6" "admap")})
+    {
+        anyFound = anyFound || CommandParsing::lookup(word, type);
+    }
+    check(!anyFound, "prefixes, extensions, embedded NULs and non-ASCII bytes match nothing");
+
+    cout << "=== End of Command Parsing Driver ===" << endl;
+}
+
+void testBatchCommandProcessor()
+{
+    cout << "=== Batch Command Processor Driver ===" << endl;
+
+    const string path = (std::filesystem::temp_directory_path() / "risk-driver-batch.txt").string();
+    std::ofstream(path, std::ios::binary | std::ios::trunc)
+        << "\n  loadmap Americas 1792.map\r\n \t \n\r\nvalidatemap\n\naddplayer Ann";
+
+    BatchFileCommandProcessor batch(path);
+    check(batch.commandCount() == 3 && batch.hasMoreCommands(), "blank lines are skipped when the script is split");
+    check(batch.getHistoryLimit() == 0, "batch mode keeps no command history");
+
+    const CommandTypes order[] = {LoadMap, ValidateMap, AddPlayer};
+    bool served = true;
+    for (CommandTypes type : order)
+    {
+        Command* command = batch.getCommand();
+        served = served && command && command->getType() == type;
+        if (command)
+        {
+            batch.setState(command->getEffect());
+        }
+    }
+    check(served, "the script's commands come back in order");
+    check(!batch.hasMoreCommands(), "the source reports its end after serving the last command");
+    check(batch.getCommand() == nullptr, "reading past the end returns nullptr instead of throwing");
+
+    std::filesystem::remove(path);
+    cout << "=== End of Batch Command Processor Driver ===" << endl;
+}
+
+void testQueueCommandProcessor()
+{
+    cout << "=== Queue Command Processor Driver ===" << endl;
+
+    // A small ring so the producer keeps wrapping around and finding it full.
+    const int count = 1000000;
+    SpscQueue<int> ring(64);
+    std::thread producer([&ring, count]()
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            while (!ring.tryPush(i))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int expected = 0;
+    bool inOrder = true;
+    while (expected < count)
+    {
+        int value = -1;
+        if (!ring.tryPop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        inOrder = inOrder && value == expected;
+        ++expected;
+    }
+    producer.join();
+    check(inOrder && ring.empty(), std::to_string(count) + " values crossed threads in order, none lost or repeated");
+
+    QueueCommandProcessor queue(4);
+    queue.setState(State::Start);
+    const char* script[] = {"loadmap Americas 1792.map", "validatemap", "addplayer Ann", "addplayer Bo", "gamestart"};
+    std::thread feeder([&queue, &script]()
+    {
+        for (const char* line : script)
+        {
+            while (!queue.push(line))
+            {
+                std::this_thread::yield();
+            }
+        }
+        queue.close();
+    });
+    const CommandTypes order[] = {LoadMap, ValidateMap, AddPlayer, AddPlayer, GameStart};
+    bool received = true;
+    for (CommandTypes type : order)
+    {
+        Command* command = queue.getCommand();
+        received = received && command && command->getType() == type;
+        if (command)
+        {
+            queue.setState(command->getEffect());
+        }
+    }
+    const bool ended = queue.getCommand() == nullptr && !queue.hasMoreCommands();
+    feeder.join();
+    check(received, "commands pushed from another thread arrive in order");
+    check(ended, "once closed and drained the queue returns nullptr");
+    check(!queue.push("quit"), "a closed queue refuses more commands");
+
+    // Commands come back in one reused object, and only the latest few are kept for printing.
+    QueueCommandProcessor reused(8);
+    reused.setState(State::PlayersAdded);
+    reused.setHistoryLimit(2);
+    for (const char* line : {"addplayer Ann", "addplayer Bo", "addplayer Cy"})
+    {
+        reused.push(line);
+    }
+    reused.close();
+    Command* first = reused.getCommand();
+    Command* second = reused.getCommand();
+    Command* third = reused.getCommand();
+    check(first == second && second == third && third->getParameter() == "Cy", "every command is served in the same object");
+    std::ostringstream printed;
+    printed << reused;
+    const string history = printed.str();
+    check(history.find("Ann") == string::npos && history.find("Bo") < history.find("Cy"),
+          "the history keeps the latest commands up to its limit, oldest first");
+
+    // The phase-end commands are only taken in their own phase; the other one is skipped.
+    QueueCommandProcessor phases(4);
+    phases.setState(State::IssueOrders);
+    for (const char* line : {"endexecorders", "gamestart", "EndIssueOrders"})
+    {
+        phases.push(line);
+    }
+    phases.close();
+    Command* phaseEnd = phases.getCommand();
+    check(phaseEnd && phaseEnd->getType() == EndIssueOrders && phaseEnd->getEffect() == State::ExecuteOrders &&
+              !phases.hasMoreCommands(),
+          "while issuing orders only endissueorders is accepted, and it leads to executing them");
+
+    cout << "=== End of Queue Command Processor Driver ===" << endl;
+}
@@ -5,4 +5,7 @@
 
 #include "CommandProcessing.h"
 
-void testCommandProcessor(int argc, char* argv[]);
\ No newline at end of file
+void testCommandProcessor(int argc, char* argv[]);
+void testCommandParsing();
+void testBatchCommandProcessor();
+void testQueueCommandProcessor();
\ No newline at end of file
@@ -0,0 +1,78 @@
+//
+// CowArray.h
+// Fixed-size array with copy-on-write pages.
+//
+
+#ifndef COMP345_RISK_COWARRAY_H
+#define COMP345_RISK_COWARRAY_H
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * Fixed-size array split into pages that are shared between copies.
+ *
+ * Copying a CowArray copies one pointer. The first write to a copy clones the page table,
+ * and every later write clones only the page it touches if another copy still shares it.
+ * So a fork costs O(1) and its writes cost O(changed pages).
+ *
+ * Copies may live on different threads. A single CowArray must not be written while another
+ * thread reads or copies that same object.
+ */
+template <typename T, size_t PageSize = 64>
+class CowArray {
+public:
+    CowArray() : table(std::make_shared<Table>()) {}
+
+    explicit CowArray(size_t size, const T& value = T()) : table(std::make_shared<Table>()) {
+        table->size = size;
+        const size_t pageCount = (size + PageSize - 1) / PageSize;
+        auto page = std::make_shared<Page>();
+        page->fill(value);
+        // Every page starts out as the same filled page; writes split them apart.
+        table->pages.assign(pageCount, page);
+    }
+
+    size_t size() const { return table->size; }
+
+    const T& operator[](size_t i) const {
+        return (*table->pages[i / PageSize])[i % PageSize];
+    }
+
+    void set(size_t i, const T& value) {
+        if ((*this)[i] == value) return;
+        mutableAt(i) = value;
+    }
+
+    T& mutableAt(size_t i) {
+        if (table.use_count() != 1) {
+            table = std::make_shared<Table>(*table);
+        }
+        std::shared_ptr<Page>& page = table->pages[i / PageSize];
+        if (page.use_count() != 1) {
+            page = std::make_shared<Page>(*page);
+        }
+        return (*page)[i % PageSize];
+    }
+
+    /**
+     * True if both arrays still point at the same page for the given index.
+     */
+    bool sharesPage(const CowArray& other, size_t i) const {
+        return table->pages[i / PageSize] == other.table->pages[i / PageSize];
+    }
+
+private:
+    using Page = std::array<T, PageSize>;
+
+    struct Table {
+        std::vector<std::shared_ptr<Page>> pages;
+        size_t size = 0;
+    };
+
+    std::shared_ptr<Table> table;
+};
+
+#endif // COMP345_RISK_COWARRAY_H
@@ -0,0 +1,60 @@
+//
+// Decision.cpp
+// Time limits and cancellation for strategy decisions, and their latency records.
+//
+
+#include "Decision.h"
+#include <algorithm>
+
+LatencyHistogram::LatencyHistogram() : samples(0), totalMicros(0), slowestMicros(0) {
+    for (auto& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds elapsed) {
+    const uint64_t micros = static_cast<uint64_t>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+
+    int bucket = 0;
+    while (bucket < BUCKETS - 1 && (micros >> bucket) != 0) ++bucket;
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    samples.fetch_add(1, std::memory_order_relaxed);
+    totalMicros.fetch_add(micros, std::memory_order_relaxed);
+
+    uint64_t slowest = slowestMicros.load(std::memory_order_relaxed);
+    while (micros > slowest && !slowestMicros.compare_exchange_weak(slowest, micros, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t LatencyHistogram::count() const {
+    return samples.load(std::memory_order_relaxed);
+}
+
+double LatencyHistogram::meanMicros() const {
+    const uint64_t n = count();
+    return n ? static_cast<double>(totalMicros.load(std::memory_order_relaxed)) / n : 0.0;
+}
+
+uint64_t LatencyHistogram::maxMicros() const {
+    return slowestMicros.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::percentileMicros(double quantile) const {
+    const uint64_t n = count();
+    if (n == 0) return 0;
+    const double clamped = quantile < 0.0 ? 0.0 : (quantile > 1.0 ? 1.0 : quantile);
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(clamped * n + 0.5));
+
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; ++b) {
+        seen += buckets[b].load(std::memory_order_relaxed);
+        if (seen >= rank) return b == 0 ? 1 : (uint64_t(1) << b);
+    }
+    return maxMicros();
+}
+
+std::ostream& operator<<(std::ostream& os, const LatencyHistogram& histogram) {
+    os << histogram.count() << " decisions, mean " << static_cast<uint64_t>(histogram.meanMicros())
+       << "us, p50 <" << histogram.percentileMicros(0.5)
+       << "us, p99 <" << histogram.percentileMicros(0.99)
+       << "us, max " << histogram.maxMicros() << "us";
+    return os;
+}
@@ -0,0 +1,87 @@
+//
+// Decision.h
+// Time limits and cancellation for strategy decisions, and their latency records.
+//
+
+#ifndef COMP345_RISK_DECISION_H
+#define COMP345_RISK_DECISION_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+
+/**
+ * Shared cancellation flag. Copies refer to the same flag, so the engine keeps one copy and
+ * hands the others to strategies; cancel() from any thread is seen by all of them.
+ */
+class CancellationToken {
+public:
+    CancellationToken() : flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() const { flag->store(true, std::memory_order_release); }
+    bool isCancelled() const { return flag->load(std::memory_order_acquire); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag;
+};
+
+/**
+ * Limits of one issueOrder() call. Strategies that can stop early (anytime strategies) check
+ * shouldStop() as they go and return the best orders found so far; the rest may ignore it.
+ */
+struct DecisionContext {
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point deadline = Clock::time_point::max();
+    CancellationToken token;
+    // Threads a strategy may search with, 0 for no limit. Set when several strategies decide at
+    // once, so together they don't ask for more threads than the shared pool has.
+    size_t threads = 0;
+
+    bool shouldStop() const { return token.isCancelled() || Clock::now() >= deadline; }
+
+    static DecisionContext within(std::chrono::milliseconds budget, const CancellationToken& token = CancellationToken()) {
+        DecisionContext context;
+        context.deadline = Clock::now() + budget;
+        context.token = token;
+        return context;
+    }
+};
+
+/**
+ * Latency histogram with power-of-two microsecond buckets: bucket b counts durations
+ * in [2^(b-1), 2^b) microseconds, bucket 0 those under a microsecond.
+ * record() is lock-free, so strategies on several threads can report into the same histogram.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int BUCKETS = 32;
+
+    LatencyHistogram();
+    LatencyHistogram(const LatencyHistogram& other) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram& other) = delete;
+
+    void record(std::chrono::nanoseconds elapsed);
+
+    uint64_t count() const;
+    double meanMicros() const;
+    uint64_t maxMicros() const;
+
+    /**
+     * Upper bound, in microseconds, of the bucket holding the given quantile (0..1).
+     */
+    uint64_t percentileMicros(double quantile) const;
+
+    friend std::ostream& operator<<(std::ostream& os, const LatencyHistogram& histogram);
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets;
+    std::atomic<uint64_t> samples;
+    std::atomic<uint64_t> totalMicros;
+    std::atomic<uint64_t> slowestMicros;
+};
+
+#endif // COMP345_RISK_DECISION_H
@@ -0,0 +1,19 @@
+//
+// DriverCheck.h
+// Checks for the driver functions.
+//
+
+#ifndef COMP345_RISK_DRIVERCHECK_H
+#define COMP345_RISK_DRIVERCHECK_H
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+// Prints what was verified, or throws std::runtime_error naming it if it doesn't hold.
+inline void check(bool condition, const std::string& what) {
+    if (!condition) throw std::runtime_error("Check failed: " + what);
+    std::cout << "  ok: " << what << "\n";
+}
+
+#endif // COMP345_RISK_DRIVERCHECK_H
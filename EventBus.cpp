@@ -0,0 +1,57 @@
+//
+// EventBus.cpp
+// Notifications raised while orders execute.
+//
+
+#include "EventBus.h"
+#include <algorithm>
+
+EventBus::EventBus() : nextId(1), publishing(0), dirty(false) {}
+
+EventBus::SubscriptionId EventBus::subscribe(GameEventType type, Handler handler, const Player* target, bool once) {
+    const SubscriptionId id = nextId++;
+    subscribers[static_cast<size_t>(type)].push_back(Subscription{id, target, once, std::move(handler)});
+    return id;
+}
+
+void EventBus::unsubscribe(SubscriptionId id) {
+    for (auto& list : subscribers) {
+        for (auto& s : list) {
+            if (s.id == id) {
+                s.id = 0;
+                dirty = true;
+                if (publishing == 0) compact();
+                return;
+            }
+        }
+    }
+}
+
+void EventBus::publish(const GameEvent& event) {
+    auto& list = subscribers[static_cast<size_t>(event.type)];
+    ++publishing;
+    // Subscriptions added by a handler go to the back and don't see the event being delivered.
+    const size_t count = list.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (list[i].id == 0) continue;
+        if (list[i].target && list[i].target != event.target) continue;
+        if (list[i].once) {
+            list[i].id = 0;
+            dirty = true;
+        }
+        list[i].handler(event);
+    }
+    if (--publishing == 0 && dirty) compact();
+}
+
+size_t EventBus::subscriberCount(GameEventType type) const {
+    const auto& list = subscribers[static_cast<size_t>(type)];
+    return static_cast<size_t>(std::count_if(list.begin(), list.end(), [](const Subscription& s) { return s.id != 0; }));
+}
+
+void EventBus::compact() {
+    for (auto& list : subscribers) {
+        list.erase(std::remove_if(list.begin(), list.end(), [](const Subscription& s) { return s.id == 0; }), list.end());
+    }
+    dirty = false;
+}
@@ -0,0 +1,87 @@
+//
+// EventBus.h
+// Notifications raised while orders execute.
+//
+
+#ifndef COMP345_RISK_EVENTBUS_H
+#define COMP345_RISK_EVENTBUS_H
+
+#include "Map.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+class Player;
+enum class CardType : uint8_t;
+
+enum class GameEventType : uint8_t {
+    TerritoryAttacked,   // actor attacked (or bombed) a territory owned by target
+    TerritoryConquered,  // actor took the territory from target
+    CardDrawn,           // actor drew a card of kind card
+    CardPlayed,          // actor played a card of kind card; it is back in the deck
+    Count
+};
+
+/**
+ * What happened. Pointers that don't apply to the event type are null; card is only meaningful
+ * for CardDrawn and CardPlayed.
+ */
+struct GameEvent {
+    GameEventType type;
+    Player* actor;
+    Player* target;
+    Map::territoryNode* territory;
+    CardType card{};
+};
+
+/**
+ * Synchronous publish/subscribe for game events.
+ *
+ * Subscribers are kept per event type, and may ask only for events whose target is a given
+ * player, so publishing costs one pointer compare per subscriber of that type and calls only
+ * the handlers that care. Nothing is allocated while publishing.
+ *
+ * Handlers may subscribe or unsubscribe (themselves included) while an event is being delivered;
+ * removals take effect immediately and the list is compacted once delivery is over.
+ * Not thread-safe: events are published from the thread executing orders.
+ */
+class EventBus {
+public:
+    using Handler = std::function<void(const GameEvent&)>;
+    using SubscriptionId = size_t;
+
+    EventBus();
+    EventBus(const EventBus& other) = delete;
+    EventBus& operator=(const EventBus& other) = delete;
+
+    /**
+     * Registers a handler for one event type. With a target, only events whose target is that
+     * player are delivered. A one-shot subscription is removed after its first delivery.
+     */
+    SubscriptionId subscribe(GameEventType type, Handler handler, const Player* target = nullptr, bool once = false);
+    void unsubscribe(SubscriptionId id);
+
+    void publish(const GameEvent& event);
+
+    size_t subscriberCount(GameEventType type) const;
+
+private:
+    struct Subscription {
+        SubscriptionId id;  // 0 once unsubscribed
+        const Player* target;
+        bool once;
+        Handler handler;
+    };
+
+    // deque: subscribing from inside a handler must not move the handler that is running.
+    std::array<std::deque<Subscription>, static_cast<size_t>(GameEventType::Count)> subscribers;
+    SubscriptionId nextId;
+    int publishing;  // nesting depth; compaction waits until it drops back to 0
+    bool dirty;
+
+    void compact();
+};
+
+#endif // COMP345_RISK_EVENTBUS_H
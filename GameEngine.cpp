@@ -7,14 +7,23 @@
 #include "MapLoader.h"
 #include "Player.h"
 #include "PlayerStrategies.h"
+#include "StrategyRegistry.h"
 #include "Map.h"
 #include "Cards.h"
+#include "ThreadPool.h"
+#include "BinaryIO.h"
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <cstring>
+#include <exception>
 #include <filesystem>
+#include <future>
 #include <iostream>
 #include <numeric>
 #include <random>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <system_error>
@@ -78,6 +87,117 @@ std::string findMatchingMapName(const std::vector<std::string>& availableMaps, c
     return "";
 }
 
+// FNV-1a over every territory's name, continent and borders, so a checkpoint is never restored
+// onto a different or edited map that happens to have the same file name.
+uint64_t mapFingerprint(const Map& map)
+{
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    for (const auto& node : map.getTerritoryNodes())
+    {
+        mix(node.name.c_str(), node.name.size() + 1);
+        mix(node.continent.c_str(), node.continent.size() + 1);
+        for (int adjacent : node.adjacentIndices)
+        {
+            const int32_t index = adjacent;
+            mix(&index, sizeof(index));
+        }
+        const int32_t end = -1;
+        mix(&end, sizeof(end));
+    }
+    return hash;
+}
+
+const char CHECKPOINT_MAGIC[4] = {'R', 'C', 'K', 'P'};
+
+// How a checkpoint rebuilds a player's strategy. Strategies with settings carry them, so nothing
+// depends on what happens to be registered in the process that loads the checkpoint.
+enum class SavedStrategyKind : uint8_t { Registered = 0, MCTS, Script };
+
+struct SavedStrategy
+{
+    SavedStrategyKind kind = SavedStrategyKind::Registered;
+    std::string name;
+    int32_t iterations = 0;
+    int32_t timeBudgetMs = 0;
+    uint32_t threads = 0;
+    std::shared_ptr<const StrategyScript> script;
+};
+
+void writeStrategy(ByteWriter& out, const PlayerStrategy* strategy)
+{
+    if (auto* mcts = dynamic_cast<const MCTSPlayerStrategy*>(strategy))
+    {
+        out.u8(static_cast<uint8_t>(SavedStrategyKind::MCTS));
+        out.i32(mcts->getIterationBudget());
+        out.i32(mcts->getTimeBudget());
+        out.u32(static_cast<uint32_t>(mcts->getThreads()));
+    }
+    else if (auto* scripted = dynamic_cast<const ScriptedPlayerStrategy*>(strategy))
+    {
+        out.u8(static_cast<uint8_t>(SavedStrategyKind::Script));
+        out.str(scripted->getScript().getText());
+    }
+    else
+    {
+        out.u8(static_cast<uint8_t>(SavedStrategyKind::Registered));
+        out.str(strategy ? strategy->getStrategyName() : "Human");
+    }
+}
+
+// Throws std::runtime_error if the strategy can't be rebuilt here.
+SavedStrategy readStrategy(ByteReader& in, const std::string& path)
+{
+    SavedStrategy saved;
+    saved.kind = static_cast<SavedStrategyKind>(in.u8());
+    switch (saved.kind)
+    {
+    case SavedStrategyKind::Registered:
+        saved.name = in.str();
+        if (in.ok() && !StrategyRegistry::contains(saved.name))
+        {
+            throw std::runtime_error("Checkpoint " + path + " uses strategy '" + saved.name +
+                                     "', which is not registered in this program");
+        }
+        break;
+    case SavedStrategyKind::MCTS:
+        saved.iterations = in.i32();
+        saved.timeBudgetMs = in.i32();
+        saved.threads = in.u32();
+        break;
+    case SavedStrategyKind::Script:
+    {
+        std::istringstream text(in.str());
+        saved.script = std::make_shared<const StrategyScript>(StrategyScript::parse(text, path));
+        break;
+    }
+    default:
+        throw std::runtime_error("Malformed checkpoint: " + path);
+    }
+    return saved;
+}
+
+std::unique_ptr<PlayerStrategy> makeStrategy(const SavedStrategy& saved, Player* player)
+{
+    switch (saved.kind)
+    {
+    case SavedStrategyKind::MCTS:
+        return std::make_unique<MCTSPlayerStrategy>(player, saved.iterations, saved.timeBudgetMs, saved.threads);
+    case SavedStrategyKind::Script:
+        return std::make_unique<ScriptedPlayerStrategy>(player, saved.script);
+    case SavedStrategyKind::Registered:
+        break;
+    }
+    return StrategyRegistry::create(saved.name, player);
+}
+
 fs::path resolveMapPath(const std::vector<std::string>& availableMaps,
                         const std::string& requested,
                         const std::string& mapDirectory)
@@ -164,7 +284,9 @@ GameEngine::GameEngine()
       mapValidated(false),
       loadedMap(nullptr),
       players(),
-      deck(std::make_unique<Deck>(STARTING_DECK_SIZE))
+      deck(std::make_unique<Deck>(STARTING_DECK_SIZE)),
+      gameState(nullptr),
+      decisionTimeMs(DEFAULT_DECISION_TIME_MS)
 {
 
     // startup
@@ -232,6 +354,10 @@ bool GameEngine::apply(const std::string& cmd) {
 
     //apply transition 
     current = itCmd->second;  
+    if (gameState)
+    {
+        gameState->setPhase(current);
+    }
     return true;
 }
 
@@ -256,6 +382,7 @@ void GameEngine::startupPhase(CommandProcessor& commandProcessor, const std::str
     std::cout << "[StartupPhase] Commands: loadmap <file>, validatemap, addplayer <name>, gamestart\n";
 
     commandProcessor.setState(state());
+    commandProcessor.setJournal(journal.get());
 
     auto loadMapCommand = [&](const std::string& parameter) -> bool {
         const fs::path candidatePath = resolveMapPath(availableMaps, parameter, mapDirectory);
@@ -269,8 +396,10 @@ void GameEngine::startupPhase(CommandProcessor& commandProcessor, const std::str
         {
             MapLoader loader(candidatePath.string());
             loadedMap = std::make_unique<Map>(loader.getMap());
+            loadedMapPath = candidatePath.string();
             mapLoaded = true;
             mapValidated = false;
+            gameState.reset();
             players.clear();
             deck = std::make_unique<Deck>(STARTING_DECK_SIZE);
             availableMaps = collectMapFiles(mapDirectory);
@@ -363,8 +492,12 @@ void GameEngine::startupPhase(CommandProcessor& commandProcessor, const std::str
             return false;
         }
 
-        std::random_device rd;
-        std::mt19937 rng(rd());
+        const uint32_t seed = replaySeed ? *replaySeed : std::random_device{}();
+        std::mt19937 rng(seed);
+        JournalRecord seedRecord;
+        seedRecord.type = JournalRecordType::Seed;
+        seedRecord.value = static_cast<int32_t>(seed);
+        record(seedRecord);
 
         std::shuffle(players.begin(), players.end(), rng);
 
@@ -384,16 +517,26 @@ void GameEngine::startupPhase(CommandProcessor& commandProcessor, const std::str
             players[i % players.size()]->addTerritory(territory);
         }
 
-        deck = std::make_unique<Deck>(STARTING_DECK_SIZE);
+        deck = std::make_unique<Deck>(STARTING_DECK_SIZE, rng());
+
+        std::vector<Player*> gamePlayers;
+        for (auto& player : players)
+        {
+            gamePlayers.push_back(player.get());
+        }
+        gameState = std::make_unique<GameState>(loadedMap.get(), gamePlayers, deck.get(), rng());
+        gameState->setPhase(current);
+        attachGameState();
 
         for (auto& player : players)
         {
             player->setReinforcementPool(INITIAL_REINFORCEMENT_POOL);
             for (int i = 0; i < INITIAL_CARD_DRAW; ++i)
             {
-                if (Card* card = deck->draw())
+                auto card = deck->draw();
+                if (card && !player->addCard(*card))
                 {
-                    player->addCard(card);
+                    deck->returnCard(*card);
                 }
             }
         }
@@ -434,6 +577,11 @@ void GameEngine::startupPhase(CommandProcessor& commandProcessor, const std::str
 
         if (!command)
         {
+            if (!commandProcessor.hasMoreCommands())
+            {
+                std::cout << "[StartupPhase] No more commands.\n";
+                break;
+            }
             std::cout << "[StartupPhase] Received an invalid command.\n";
             continue;
         }
@@ -493,6 +641,19 @@ void GameEngine::startupPhase(CommandProcessor& commandProcessor, const std::str
     }
 }
 
+std::string GameEngine::registerStrategyScript(const std::string& path) {
+    auto script = std::make_shared<const StrategyScript>(StrategyScript::load(path));
+    const std::string name = script->getName();
+    const bool registered = StrategyRegistry::add(name, [script](Player* player) {
+        return std::unique_ptr<PlayerStrategy>(new ScriptedPlayerStrategy(player, script));
+    }, true);
+    if (!registered) {
+        throw std::runtime_error("Strategy script " + path + " uses the name of a built-in strategy: " + name);
+    }
+    std::cout << "[GameEngine] Registered strategy script " << name << " from " << path << "\n";
+    return name;
+}
+
 void GameEngine::assignStrategyToPlayer(size_t playerIndex, const std::string& strategyName) {
     if (playerIndex >= players.size()) {
         std::cout << "[GameEngine] Invalid player index: " << playerIndex << "\n";
@@ -500,83 +661,650 @@ void GameEngine::assignStrategyToPlayer(size_t playerIndex, const std::string& s
     }
 
     Player* player = players[playerIndex].get();
-    PlayerStrategy* newStrategy = nullptr;
-
-    std::string lowerName = strategyName;
-    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
-
-    if (lowerName == "human") {
-        newStrategy = new HumanPlayerStrategy(player);
-    } else if (lowerName == "aggressive") {
-        newStrategy = new AggressivePlayerStrategy(player);
-    } else if (lowerName == "benevolent") {
-        newStrategy = new BenevolentPlayerStrategy(player);
-    } else if (lowerName == "neutral") {
-        newStrategy = new NeutralPlayerStrategy(player);
-    } else if (lowerName == "cheater") {
-        newStrategy = new CheaterPlayerStrategy(player);
+    std::unique_ptr<PlayerStrategy> newStrategy;
+
+    if (toLowerCopy(strategyName).rfind("script:", 0) == 0) {
+        try {
+            newStrategy = StrategyRegistry::create(registerStrategyScript(strategyName.substr(7)), player);
+        } catch (const std::exception& e) {
+            std::cout << "[GameEngine] " << e.what() << ". Using Human strategy.\n";
+        }
     } else {
-        std::cout << "[GameEngine] Unknown strategy name: " << strategyName << ". Using Human strategy.\n";
-        newStrategy = new HumanPlayerStrategy(player);
+        newStrategy = StrategyRegistry::create(strategyName, player);
+        if (!newStrategy) {
+            std::cout << "[GameEngine] Unknown strategy name: " << strategyName << ". Using Human strategy.\n";
+        }
+    }
+    if (!newStrategy) {
+        newStrategy = std::make_unique<HumanPlayerStrategy>(player);
     }
 
-    player->setStrategy(newStrategy);
+    player->setStrategy(newStrategy.release());
     std::cout << "[GameEngine] Assigned " << strategyName << " strategy to " << player->getName() << "\n";
 }
 
+void GameEngine::issueOrdersForAll() {
+    // Bots that only read the board plan their orders together on the engine's decision pool,
+    // against the position at the start of the phase. Their orders are held back and committed in
+    // player order afterwards, so the order lists come out as if they had gone one after another.
+    {
+        std::lock_guard<std::mutex> lock(decisionMutex);
+        decisionToken = CancellationToken();
+    }
+
+    std::vector<Player*> concurrent;
+    std::vector<Player*> serial;
+    // Histograms are looked up once here, so a strategy swapped mid-phase still reports into the
+    // histogram of the strategy that started deciding.
+    std::unordered_map<const Player*, LatencyHistogram*> latency;
+    for (auto& owned : players) {
+        Player* player = owned.get();
+        if (!player->getStrategy()) {
+            std::cout << "[GameEngine] Warning: " << player->getName()
+                      << " has no strategy assigned.\n";
+            continue;
+        }
+        auto& histogram = decisionLatency[player->getStrategy()->getStrategyName()];
+        if (!histogram) histogram = std::make_unique<LatencyHistogram>();
+        latency[player] = histogram.get();
+        if (gameState && player->getStrategy()->canIssueConcurrently()) {
+            concurrent.push_back(player);
+        } else {
+            serial.push_back(player);
+        }
+    }
+
+    if (concurrent.size() == 1) {
+        serial.insert(serial.begin(), concurrent.front());
+        concurrent.clear();
+    }
+    if (!concurrent.empty()) {
+        if (!decisionPool) decisionPool = std::make_unique<ThreadPool>(MAX_PLAYERS);
+        // Bots that search in parallel split the shared pool between them instead of each one
+        // asking for all of it.
+        const size_t threads = std::max<size_t>(1, ThreadPool::shared().size() / concurrent.size());
+
+        gameState->freezeSnapshot();
+        std::vector<std::future<void>> pending;
+        pending.reserve(concurrent.size());
+        for (Player* player : concurrent) {
+            player->holdOrders();
+            LatencyHistogram* histogram = latency[player];
+            pending.push_back(decisionPool->submit([this, player, histogram, threads] { decide(player, *histogram, threads); }));
+        }
+        std::exception_ptr failure;
+        for (auto& result : pending) {
+            try {
+                result.get();
+            } catch (...) {
+                if (!failure) failure = std::current_exception();
+            }
+        }
+        gameState->thawSnapshot();
+        for (auto& player : players) {
+            if (std::find(concurrent.begin(), concurrent.end(), player.get()) != concurrent.end()) {
+                player->releaseOrders();
+            }
+        }
+        if (failure) std::rethrow_exception(failure);
+    }
+
+    // Humans and strategies that change the board go one at a time, in player order.
+    for (Player* player : serial) {
+        if (gameState) {
+            gameState->setCurrentPlayer(player);
+        }
+        decide(player, *latency[player]);
+    }
+
+    if (gameState) {
+        for (auto& owned : players) {
+            playCards(owned.get());
+        }
+    }
+}
+
+void GameEngine::playCards(Player* player) {
+    Hand* hand = player->getHand();
+    for (int i = 0; i < CARD_TYPE_COUNT; ++i) {
+        Card card(static_cast<CardType>(i));
+        while (hand->count(card.getType()) > 0 && card.play(player, gameState->getDeck(), hand)) {
+        }
+    }
+}
+
+void GameEngine::decide(Player* player, LatencyHistogram& latency, size_t threads) {
+    CancellationToken token;
+    {
+        std::lock_guard<std::mutex> lock(decisionMutex);
+        token = decisionToken;
+    }
+    DecisionContext context = DecisionContext::within(std::chrono::milliseconds(decisionTimeMs), token);
+    context.threads = threads;
+    const auto start = std::chrono::steady_clock::now();
+    player->issueOrder(context);  // This delegates to the strategy
+    latency.record(std::chrono::steady_clock::now() - start);
+}
+
+void GameEngine::setDecisionTime(int milliseconds) {
+    decisionTimeMs = std::max(1, milliseconds);
+}
+
+void GameEngine::cancelDecisions() {
+    std::lock_guard<std::mutex> lock(decisionMutex);
+    decisionToken.cancel();
+}
+
+const LatencyHistogram* GameEngine::getDecisionLatency(const std::string& strategyName) const {
+    auto it = decisionLatency.find(strategyName);
+    return it == decisionLatency.end() ? nullptr : it->second.get();
+}
+
+void GameEngine::printDecisionLatency(std::ostream& os) const {
+    for (const auto& entry : decisionLatency) {
+        os << "[GameEngine] " << entry.first << ": " << *entry.second << "\n";
+    }
+}
+
+void GameEngine::reinforcementPhase() {
+    std::cout << "\n--- Reinforcement Phase ---\n";
+    JournalRecord reinforce;
+    reinforce.type = JournalRecordType::Reinforce;
+    record(reinforce);
+    // Calculate and assign reinforcements based on territories owned
+    // For now, we'll use a simple calculation
+    for (auto& player : players) {
+        int territories = static_cast<int>(player->getOwnedTerritories()->size());
+        int reinforcements = std::max(3, territories / 3);  // At least 3, or territories/3
+        player->addReinforcements(reinforcements);
+        std::cout << "[GameEngine] " << player->getName() << " receives "
+                  << reinforcements << " reinforcements (Total: "
+                  << player->getReinforcementPool() << ")\n";
+    }
+}
+
+void GameEngine::executeOrdersPhase() {
+    std::cout << "\n--- Execute Orders Phase ---\n";
+    if (gameState) {
+        // Whoever decided last is still the current player; replays don't decide, so clear it
+        // to keep the position hash comparable.
+        gameState->setCurrentPlayer(nullptr);
+        gameState->beginTurn();
+        JournalRecord execute;
+        execute.type = JournalRecordType::Execute;
+        const uint64_t hash = gameState->getHash();
+        execute.kind = static_cast<int32_t>(static_cast<uint32_t>(hash >> 32));
+        execute.value = static_cast<int32_t>(static_cast<uint32_t>(hash));
+        record(execute);
+    }
+    // Execute all orders for all players
+    for (auto& player : players) {
+        OrdersList* orders = player->getOrdersList();
+        if (orders && !orders->empty()) {
+            std::cout << "[GameEngine] Executing orders for " << player->getName() << "\n";
+            if (gameState) {
+                gameState->setCurrentPlayer(player.get());
+                orders->executeAll(*gameState);
+            } else {
+                orders->executeAll();
+            }
+        }
+    }
+    // A Neutral player created for a blockade takes part from the next turn on. Adopted only after
+    // the loop above, which it would otherwise invalidate.
+    if (gameState) {
+        for (auto& joined : gameState->takeJoinedPlayers()) {
+            std::cout << "[GameEngine] " << joined->getName() << " joined the game to hold blockaded territories.\n";
+            players.push_back(std::move(joined));
+        }
+    }
+}
+
+void GameEngine::record(const JournalRecord& record) {
+    if (journal) journal->append(record);
+}
+
+void GameEngine::recordIssuedOrders(const std::vector<int>& listSizes) {
+    if (!journal) return;
+    for (size_t p = 0; p < players.size(); ++p) {
+        const OrdersList* orders = players[p]->getOrdersList();
+        const int first = p < listSizes.size() ? listSizes[p] : 0;
+        for (int i = first; i < orders->size(); ++i) {
+            record(JournalRecord::fromOrder(static_cast<int>(p), *orders->getOrder(i)));
+        }
+        JournalRecord pool;
+        pool.type = JournalRecordType::Pool;
+        pool.player = static_cast<int>(p);
+        pool.value = players[p]->getReinforcementPool();
+        record(pool);
+    }
+}
+
+void GameEngine::startJournal(const std::string& path, JournalOptions options) {
+    journal = std::make_unique<JournalWriter>(path, options);
+    std::cout << "[GameEngine] Journaling to " << path << "\n";
+}
+
+void GameEngine::stopJournal() {
+    journal.reset();
+}
+
+void GameEngine::replay(const std::string& journalPath, const std::string& mapDirectory) {
+    const std::vector<JournalRecord> records = JournalReader::readAll(journalPath);
+    const auto seeds = std::count_if(records.begin(), records.end(), [](const JournalRecord& r) {
+        return r.type == JournalRecordType::Seed;
+    });
+    if (seeds > 1) {
+        throw std::runtime_error("Journal holds more than one game: " + journalPath);
+    }
+    std::cout << "=== Replaying " << journalPath << " (" << records.size() << " records) ===\n";
+
+    // Startup commands come first; play starts at the first reinforcement phase.
+    const auto play = std::find_if(records.begin(), records.end(), [](const JournalRecord& r) {
+        return r.type == JournalRecordType::Reinforce;
+    });
+    const std::vector<JournalRecord> startup(records.begin(), play);
+    for (const JournalRecord& r : startup) {
+        if (r.type == JournalRecordType::Seed) replaySeed = static_cast<uint32_t>(r.value);
+    }
+
+    std::unique_ptr<JournalWriter> detached = std::move(journal);
+    struct Restore {
+        GameEngine& engine;
+        std::unique_ptr<JournalWriter>& detached;
+        ~Restore() {
+            engine.journal = std::move(detached);
+            engine.replaySeed.reset();
+        }
+    } restore{*this, detached};
+
+    JournalCommandProcessor commands(startup);
+    startupPhase(commands, mapDirectory);
+    if (state() != State::AssignReinforcement || !replaySeed) {
+        throw std::runtime_error("Journal does not start a game: " + journalPath);
+    }
+
+    int turns = 0;
+    for (auto it = play; it != records.end(); ++it) {
+        const JournalRecord& r = *it;
+        Player* player = r.player >= 0 && static_cast<size_t>(r.player) < players.size() ? players[r.player].get() : nullptr;
+        switch (r.type) {
+            case JournalRecordType::Reinforce:
+                if (state() == State::ExecuteOrders) apply("endexecorders");
+                reinforcementPhase();
+                apply("issueorder");
+                break;
+            case JournalRecordType::IssuedOrder:
+                if (player) player->issueOrder(r.toOrder());
+                break;
+            case JournalRecordType::CardPlayed:
+                if (player && player->getHand()->removeCard(static_cast<CardType>(r.kind))) {
+                    deck->returnCard(static_cast<CardType>(r.kind));
+                }
+                break;
+            case JournalRecordType::Conquest: {
+                auto& nodes = loadedMap->getTerritoryNodes();
+                if (player && r.value >= 0 && static_cast<size_t>(r.value) < nodes.size()) {
+                    gameState->setOwner(&nodes[r.value], player);
+                    gameState->awardConquestCard(player);
+                }
+                break;
+            }
+            case JournalRecordType::Pool:
+                if (player) player->setReinforcementPool(r.value);
+                break;
+            case JournalRecordType::Execute:
+                if (state() == State::IssueOrders) apply("endissueorders");
+                gameState->setCurrentPlayer(nullptr);
+                if (gameState->getHash() != (static_cast<uint64_t>(static_cast<uint32_t>(r.kind)) << 32 |
+                                             static_cast<uint32_t>(r.value))) {
+                    throw std::runtime_error("Replay diverged from the journal before turn " +
+                                             std::to_string(turns + 1) + " was executed: " + journalPath);
+                }
+                executeOrdersPhase();
+                ++turns;
+                break;
+            case JournalRecordType::Command:
+            case JournalRecordType::Seed:
+                break;
+        }
+    }
+
+    std::cout << "=== Replay finished: " << turns << " turns, state '" << name(state()) << "' ===\n";
+}
+
+void GameEngine::attachGameState() {
+    // Cards and conquests that happen while players decide aren't visible in their orders.
+    gameState->getEvents().subscribe(GameEventType::CardPlayed, [this](const GameEvent& event) {
+        JournalRecord played;
+        played.type = JournalRecordType::CardPlayed;
+        played.player = gameState->playerId(event.actor);
+        played.kind = static_cast<int32_t>(event.card);
+        if (issuing) record(played);
+    });
+    gameState->getEvents().subscribe(GameEventType::CardDrawn, [this](const GameEvent& event) {
+        std::cout << "[GameEngine] " << event.actor->getName() << " drew a " << CardsUtil::name(event.card)
+                  << " card. Remaining in deck: " << deck->size() << "\n";
+    });
+    gameState->getEvents().subscribe(GameEventType::TerritoryConquered, [this](const GameEvent& event) {
+        JournalRecord conquest;
+        conquest.type = JournalRecordType::Conquest;
+        conquest.player = gameState->playerId(event.actor);
+        conquest.value = gameState->territoryId(event.territory);
+        if (issuing) record(conquest);
+    });
+    // Everyone is watched: players made neutral later in the game need no subscription of their own.
+    for (auto& player : players) {
+        player->setGameState(gameState.get());
+        NeutralPlayerStrategy::watchForAttacks(player.get(), gameState->getEvents());
+    }
+}
+
+// Checkpoint layout, all integers little-endian, strings as u32 size + bytes:
+//
+//     "RCKP" u16 version
+//     str map path, u64 map fingerprint, u32 territory count
+//     u8 engine State, i32 decision time, u8 map validated, i32 current player
+//     u32 players, each: str name, strategy, i32 pool, u8 x 5 hand counts,
+//                        u32 territories + u32 ids in list order,
+//                        u32 unexecuted orders + (u8 JournalOrderKind, i32 armies, str, str),
+//                        u8 conquest card drawn this turn
+//     i32 x territory count armies
+//     u32 deck size + u8 card kinds in deck order, u32 deck generator
+//     u32 x 8 combat streams
+//
+// A strategy is u8 SavedStrategyKind followed by str registered name, or i32 iterations, i32 time
+// budget, u32 threads for MCTS, or str script text for scripted strategies.
+// Owners aren't stored per territory: they follow from the players' lists.
+void GameEngine::saveCheckpoint(const std::string& path) const {
+    if (!gameState || !loadedMap) {
+        throw std::runtime_error("No game has started, nothing to checkpoint");
+    }
+    auto& nodes = loadedMap->getTerritoryNodes();
+
+    std::vector<char> data;
+    data.reserve(4096);
+    ByteWriter out(data);
+    out.bytes(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    out.u16(CHECKPOINT_VERSION);
+    out.str(loadedMapPath);
+    out.u64(mapFingerprint(*loadedMap));
+    out.u32(static_cast<uint32_t>(nodes.size()));
+    out.u8(static_cast<uint8_t>(current));
+    out.i32(decisionTimeMs);
+    out.u8(mapValidated ? 1 : 0);
+    out.i32(gameState->snapshot().getCurrentPlayer());
+
+    out.u32(static_cast<uint32_t>(players.size()));
+    for (const auto& player : players) {
+        out.str(player->getName());
+        writeStrategy(out, player->getStrategy());
+        out.i32(player->getReinforcementPool());
+        for (uint8_t count : player->getHand()->getCounts()) out.u8(count);
+
+        const auto* owned = player->getOwnedTerritories();
+        out.u32(static_cast<uint32_t>(owned->size()));
+        for (const Map::territoryNode* territory : *owned) {
+            out.u32(static_cast<uint32_t>(gameState->territoryId(territory)));
+        }
+
+        const OrdersList* orders = player->getOrdersList();
+        std::vector<JournalRecord> pending;
+        for (int i = 0; i < orders->size(); ++i) {
+            const Order* order = orders->getOrder(i);
+            if (order && !order->isExecuted()) pending.push_back(JournalRecord::fromOrder(-1, *order));
+        }
+        out.u32(static_cast<uint32_t>(pending.size()));
+        for (const JournalRecord& order : pending) {
+            out.u8(static_cast<uint8_t>(order.kind));
+            out.i32(order.value);
+            out.str(order.first);
+            out.str(order.second);
+        }
+        out.u8(gameState->hasConquestCard(player.get()) ? 1 : 0);
+    }
+
+    for (const auto& node : nodes) out.i32(node.armies);
+
+    const std::vector<CardType>& cards = deck->getCards();
+    out.u32(static_cast<uint32_t>(cards.size()));
+    for (CardType card : cards) out.u8(static_cast<uint8_t>(card));
+    out.u32(deck->getRngState());
+    for (uint32_t lane : gameState->getCombat().getLanes()) out.u32(lane);
+
+    const std::string temporary = path + ".tmp";
+    std::error_code error;
+    if (!writeFileBytes(temporary, data)) {
+        fs::remove(temporary, error);
+        throw std::runtime_error("Could not write checkpoint: " + path);
+    }
+    fs::rename(temporary, path, error);
+    if (error) {
+        fs::remove(temporary, error);
+        throw std::runtime_error("Could not write checkpoint: " + path);
+    }
+    std::cout << "[GameEngine] Saved checkpoint " << path << " (" << data.size() << " bytes)\n";
+}
+
+void GameEngine::loadCheckpoint(const std::string& path, const std::string& mapDirectory) {
+    std::vector<char> data;
+    if (!readFileBytes(path, data)) {
+        throw std::runtime_error("Could not read checkpoint: " + path);
+    }
+    const auto malformed = [&path]() { return std::runtime_error("Malformed checkpoint: " + path); };
+
+    ByteReader in(data.data(), data.size());
+    char magic[sizeof(CHECKPOINT_MAGIC)] = {};
+    if (!in.bytes(magic, sizeof(magic)) || std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0) {
+        throw std::runtime_error("Not a checkpoint: " + path);
+    }
+    const uint16_t version = in.u16();
+    if (version != CHECKPOINT_VERSION) {
+        throw std::runtime_error("Unsupported checkpoint version " + std::to_string(version) + ": " + path);
+    }
+
+    // Decode everything before touching the engine, so a bad file leaves the current game alone.
+    const std::string mapPath = in.str();
+    const uint64_t fingerprint = in.u64();
+    const uint32_t territoryCount = in.u32();
+    const uint8_t savedState = in.u8();
+    const int32_t savedDecisionTime = in.i32();
+    const bool savedValidated = in.u8() != 0;
+    const int32_t currentPlayer = in.i32();
+    // Every territory costs at least its army count, so a count the file can't hold is corrupt.
+    if (!in.ok() || territoryCount > in.remaining() / sizeof(int32_t)) {
+        throw malformed();
+    }
+    // setDecisionTime() never stores less than 1 ms; a zero or negative budget would cancel every decision.
+    if (savedDecisionTime < 1) {
+        throw malformed();
+    }
+
+    // The map itself isn't saved; reload it from where it was, or from mapDirectory after a move.
+    std::vector<fs::path> candidates{fs::path(mapPath)};
+    if (!mapDirectory.empty()) candidates.push_back(fs::path(mapDirectory) / fs::path(mapPath).filename());
+    std::unique_ptr<Map> map;
+    std::string mapFile;
+    for (const fs::path& candidate : candidates) {
+        std::error_code error;
+        if (!fs::is_regular_file(candidate, error)) continue;
+        MapLoader loader(candidate.string());
+        map = std::make_unique<Map>(loader.getMap());
+        mapFile = candidate.string();
+        break;
+    }
+    if (!map) {
+        throw std::runtime_error("Map of checkpoint " + path + " not found: " + mapPath);
+    }
+    if (mapFingerprint(*map) != fingerprint || map->getTerritoryNodes().size() != territoryCount) {
+        throw std::runtime_error("Map " + mapFile + " is not the map checkpoint " + path + " was saved on");
+    }
+
+    struct SavedPlayer {
+        std::string name;
+        SavedStrategy strategy;
+        int32_t pool = 0;
+        std::array<uint8_t, CARD_TYPE_COUNT> hand{};
+        std::vector<uint32_t> territories;
+        std::vector<JournalRecord> orders;
+        bool conquestCard = false;
+    };
+    // Blockades can add a Neutral player to a full game.
+    const uint32_t playerCount = in.u32();
+    if (!in.ok() || savedState > static_cast<uint8_t>(State::Finished) || playerCount > MAX_PLAYERS + 1) {
+        throw malformed();
+    }
+    std::vector<SavedPlayer> saved(playerCount);
+    std::vector<bool> owned(territoryCount, false);
+    for (SavedPlayer& player : saved) {
+        player.name = in.str();
+        player.strategy = readStrategy(in, path);
+        player.pool = in.i32();
+        for (uint8_t& count : player.hand) count = in.u8();
+
+        const uint32_t territories = in.u32();
+        if (territories > territoryCount) throw malformed();
+        for (uint32_t i = 0; i < territories; ++i) {
+            const uint32_t id = in.u32();
+            if (id >= territoryCount || owned[id]) throw malformed();
+            owned[id] = true;
+            player.territories.push_back(id);
+        }
+
+        const uint32_t orders = in.u32();
+        if (orders > in.remaining()) throw malformed();
+        for (uint32_t i = 0; i < orders; ++i) {
+            JournalRecord order;
+            order.type = JournalRecordType::IssuedOrder;
+            order.kind = in.u8();
+            order.value = in.i32();
+            order.first = in.str();
+            order.second = in.str();
+            if (order.kind > static_cast<int32_t>(JournalOrderKind::Negotiate)) throw malformed();
+            player.orders.push_back(std::move(order));
+        }
+        player.conquestCard = in.u8() != 0;
+        if (!in.ok()) throw malformed();
+    }
+
+    std::vector<int32_t> armies(territoryCount);
+    for (int32_t& count : armies) count = in.i32();
+
+    const uint32_t deckSize = in.u32();
+    if (deckSize > in.remaining()) throw malformed();
+    std::vector<CardType> cards;
+    cards.reserve(deckSize);
+    for (uint32_t i = 0; i < deckSize; ++i) {
+        const uint8_t kind = in.u8();
+        if (kind >= CARD_TYPE_COUNT) throw malformed();
+        cards.push_back(static_cast<CardType>(kind));
+    }
+    const uint32_t deckRng = in.u32();
+    std::array<uint32_t, CombatKernel::LANES> lanes{};
+    for (uint32_t& lane : lanes) lane = in.u32();
+    if (!in.ok() || in.remaining() != 0) throw malformed();
+
+    gameState.reset();
+    players.clear();
+
+    auto& nodes = map->getTerritoryNodes();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].owner = nullptr;
+        nodes[i].armies = armies[i];
+    }
+    for (const SavedPlayer& entry : saved) {
+        players.push_back(std::make_unique<Player>(entry.name));
+        Player* player = players.back().get();
+        player->setStrategy(makeStrategy(entry.strategy, player).release());
+        player->setReinforcementPool(entry.pool);
+        for (int kind = 0; kind < CARD_TYPE_COUNT; ++kind) {
+            for (int i = 0; i < entry.hand[kind]; ++i) player->addCard(static_cast<CardType>(kind));
+        }
+        for (uint32_t id : entry.territories) player->addTerritory(&nodes[id]);
+        for (const JournalRecord& record : entry.orders) {
+            Order* order = record.toOrder();
+            order->setIssuer(player);
+            player->getOrdersList()->addOrder(order);
+        }
+    }
+
+    deck = std::make_unique<Deck>();
+    deck->restore(std::move(cards), deckRng);
+    loadedMap = std::move(map);
+    loadedMapPath = mapFile;
+    mapLoaded = true;
+    mapValidated = savedValidated;
+    current = static_cast<State>(savedState);
+    decisionTimeMs = savedDecisionTime;
+
+    std::vector<Player*> gamePlayers;
+    for (auto& player : players) gamePlayers.push_back(player.get());
+    gameState = std::make_unique<GameState>(loadedMap.get(), gamePlayers, deck.get(), 0);
+    gameState->getCombat().setLanes(lanes);
+    gameState->setPhase(current);
+    if (currentPlayer >= 0 && static_cast<size_t>(currentPlayer) < players.size()) {
+        gameState->setCurrentPlayer(players[currentPlayer].get());
+    }
+    for (size_t p = 0; p < saved.size(); ++p) {
+        if (saved[p].conquestCard) gameState->markConquestCard(players[p].get());
+    }
+    attachGameState();
+
+    std::cout << "[GameEngine] Loaded checkpoint " << path << ": " << players.size() << " players on "
+              << loadedMap->getName() << ", state '" << name(current) << "'\n";
+}
+
 void GameEngine::mainGameLoop(CommandProcessor& commandProcessor) {
     std::cout << "\n=== Main Game Loop Started ===\n";
+    commandProcessor.setJournal(journal.get());
+
+    // The issue and execute phases end with their end command; the processor accepts no other
+    // command in those states. False once the commands run out.
+    auto endPhase = [&]() -> bool {
+        commandProcessor.setState(state());
+        Command* command = nullptr;
+        try {
+            command = commandProcessor.getCommand();
+        } catch (const std::exception& e) {
+            std::cout << "[GameEngine] Command processing error: " << e.what() << "\n";
+            return false;
+        }
+        if (!command) {
+            std::cout << "\n[GameEngine] No more commands, stopping the game.\n";
+            return false;
+        }
+        apply(CommandParsing::keyword(command->getType()));
+        return true;
+    };
 
     while (state() != State::Finished && state() != State::Win) {
         if (state() == State::AssignReinforcement) {
-            std::cout << "\n--- Reinforcement Phase ---\n";
-            // Calculate and assign reinforcements based on territories owned
-            // For now, we'll use a simple calculation
-            for (auto& player : players) {
-                int territories = static_cast<int>(player->getOwnedTerritories()->size());
-                int reinforcements = std::max(3, territories / 3);  // At least 3, or territories/3
-                player->addReinforcements(reinforcements);
-                std::cout << "[GameEngine] " << player->getName() << " receives " 
-                          << reinforcements << " reinforcements (Total: " 
-                          << player->getReinforcementPool() << ")\n";
-            }
+            reinforcementPhase();
             apply("issueorder");
         } else if (state() == State::IssueOrders) {
             std::cout << "\n--- Issue Orders Phase ---\n";
             // Each player issues orders using their strategy
+            std::vector<int> listSizes;
             for (auto& player : players) {
-                if (player->getStrategy()) {
-                    player->issueOrder();  // This delegates to the strategy
-                } else {
-                    std::cout << "[GameEngine] Warning: " << player->getName() 
-                              << " has no strategy assigned.\n";
-                }
+                listSizes.push_back(player->getOrdersList()->size());
             }
-            
-            // Check if we should continue or end order issuing
-            std::cout << "\nAll players have issued orders. Type 'endissueorders' to proceed: ";
-            std::string cmd;
-            std::getline(std::cin, cmd);
-            if (cmd == "endissueorders" || cmd == "done") {
-                apply("endissueorders");
-            }
-        } else if (state() == State::ExecuteOrders) {
-            std::cout << "\n--- Execute Orders Phase ---\n";
-            // Execute all orders for all players
-            for (auto& player : players) {
-                OrdersList* orders = player->getOrdersList();
-                if (orders && !orders->empty()) {
-                    std::cout << "[GameEngine] Executing orders for " << player->getName() << "\n";
-                    orders->executeAll();
-                }
+            issuing = true;
+            try {
+                issueOrdersForAll();
+            } catch (...) {
+                issuing = false;
+                throw;
             }
+            issuing = false;
+            recordIssuedOrders(listSizes);
             
-            std::cout << "\nAll orders executed. Type 'endexecorders' to proceed: ";
-            std::string cmd;
-            std::getline(std::cin, cmd);
-            if (cmd == "endexecorders" || cmd == "done") {
-                apply("endexecorders");
-            }
+            std::cout << "\nAll players have issued orders. Type 'endissueorders' to proceed.\n";
+            if (!endPhase()) break;
+        } else if (state() == State::ExecuteOrders) {
+            executeOrdersPhase();
+
+            std::cout << "\nAll orders executed. Type 'endexecorders' to proceed.\n";
+            if (!endPhase()) break;
         } else {
             // Handle other states or wait for commands
             Command* command = nullptr;
@@ -590,11 +1318,15 @@ void GameEngine::mainGameLoop(CommandProcessor& commandProcessor) {
             if (command) {
                 // Process command if needed
                 std::cout << "[GameEngine] Received command: " << command->getType() << "\n";
+            } else if (!commandProcessor.hasMoreCommands()) {
+                std::cout << "[GameEngine] No more commands, stopping the game.\n";
+                break;
             }
         }
     }
 
     std::cout << "\n=== Game Loop Ended ===\n";
+    printDecisionLatency(std::cout);
 }
 
 void testGameStates() {
@@ -8,12 +8,20 @@
 #include <string>
 #include <unordered_map>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include "Player.h"
 #include "PlayerStrategies.h"
 #include "Map.h"
 #include "Cards.h"
+#include "GameState.h"
+#include "Decision.h"
+#include "Journal.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <optional>
 
 class CommandProcessor;
 
@@ -46,28 +54,101 @@ class GameEngine {
         
         /**
          * Main game loop that handles reinforcement, order issuing, and order execution.
-         * This method should be called after startupPhase completes.
+         * This method should be called after startupPhase completes. Each issue and execute phase
+         * waits for its endissueorders / endexecorders command from the processor.
          */
         void mainGameLoop(CommandProcessor& commandProcessor);
 
         const std::vector<std::unique_ptr<Player>>& getPlayers() const { return players; }
         const Map* getLoadedMap() const { return loadedMap.get(); }
+        GameState* getGameState() const { return gameState.get(); }
         bool isMapLoaded() const { return mapLoaded; }
         bool isMapValidated() const { return mapValidated; }
         
         /**
          * Assigns a strategy to a player.
          * @param playerIndex Index of the player in the players vector
-         * @param strategyName Name of the strategy ("Human", "Aggressive", "Benevolent", "Neutral", "Cheater")
+         * @param strategyName Any name known to StrategyRegistry ("Human", "Aggressive", "Benevolent",
+         *                     "Neutral", "Cheater", "MCTS", registered scripts and plugins),
+         *                     or "script:<path>" to load a strategy script
          */
         void assignStrategyToPlayer(size_t playerIndex, const std::string& strategyName);
 
+        /**
+         * Loads and compiles a strategy script (see StrategyScript) and registers it with
+         * StrategyRegistry under the name declared in the script, replacing an earlier script
+         * of the same name.
+         * @return The registered name
+         * @throws std::runtime_error if the script can't be read or is malformed
+         */
+        std::string registerStrategyScript(const std::string& path);
+
+        /**
+         * Time each player's issueOrder() call is given. Strategies that can stop early return
+         * their best orders once it runs out; the others are only measured.
+         */
+        void setDecisionTime(int milliseconds);
+        int getDecisionTime() const { return decisionTimeMs; }
+
+        /**
+         * Asks every strategy still deciding in the current issue-orders phase to stop.
+         * Safe to call from any thread.
+         */
+        void cancelDecisions();
+
+        /**
+         * Decision latency recorded for a strategy name, or nullptr if it never issued orders.
+         */
+        const LatencyHistogram* getDecisionLatency(const std::string& strategyName) const;
+        void printDecisionLatency(std::ostream& os) const;
+
+        /**
+         * Journals every command, the game's random seed and every order issued from now on to an
+         * append-only file (see JournalWriter), so the game can be rebuilt with replay(). Start it
+         * before startupPhase() to capture the whole game. A journal already at the path is started
+         * over unless options.resume is set.
+         * @throws std::runtime_error if the journal can't be opened
+         */
+        void startJournal(const std::string& path, JournalOptions options = {});
+        void stopJournal();
+
+        /**
+         * Rebuilds a game from a journal: replays the startup commands with the journaled seed, then
+         * every turn with the journaled orders instead of asking the players, without any prompts.
+         * Stops with the position the journal ends in. Nothing is journaled while replaying.
+         * Positions are compared by hash, which sees armies only by bucket (see Zobrist.h), so a
+         * small difference in one stack is caught once it changes a bucket or an owner.
+         * @throws std::runtime_error if the journal can't be read, doesn't start exactly one game,
+         *         or the replayed position stops matching the journaled hashes
+         */
+        void replay(const std::string& journalPath, const std::string& mapDirectory = "Maps");
+
+        /**
+         * Saves the running game to a versioned binary checkpoint (see GameEngine.cpp for the layout):
+         * the map's path and fingerprint, every territory's owner and armies, the players with their
+         * strategies, pools, hands and unexecuted orders, the deck in order, both random generators
+         * and the engine state. The file is built in memory and written with a single write to a
+         * temporary file that then replaces path, so a crash never leaves half a checkpoint.
+         * @throws std::runtime_error if no game has started or the file can't be written
+         */
+        void saveCheckpoint(const std::string& path) const;
+
+        /**
+         * Replaces the current game with the one saved in a checkpoint, read with a single read. The
+         * map is reloaded from the saved path, or from mapDirectory if the file was moved to another
+         * machine, and must have the same fingerprint. Nothing changes if loading fails.
+         * @throws std::runtime_error if the checkpoint can't be read, is malformed, or its map can't be found
+         */
+        void loadCheckpoint(const std::string& path, const std::string& mapDirectory = "Maps");
+
     private:
         static constexpr int INITIAL_REINFORCEMENT_POOL = 50;
         static constexpr int INITIAL_CARD_DRAW = 2;
         static constexpr int STARTING_DECK_SIZE = 50;
         static constexpr size_t MIN_PLAYERS = 2;
         static constexpr size_t MAX_PLAYERS = 6;
+        static constexpr int DEFAULT_DECISION_TIME_MS = 2000;
+        static constexpr uint16_t CHECKPOINT_VERSION = 2;
 
         State current;
 
@@ -77,11 +158,54 @@ class GameEngine {
         bool mapLoaded;
         bool mapValidated;
         std::unique_ptr<Map> loadedMap;
+        std::string loadedMapPath;
         std::vector<std::unique_ptr<Player>> players;
         std::unique_ptr<Deck> deck;
+        // Built at gamestart once players, map and deck are final; orders execute against it.
+        std::unique_ptr<GameState> gameState;
+
+        // Issue-orders phase: concurrent-safe bots in parallel, everyone else serially.
+        void issueOrdersForAll();
+        // Runs one player's issueOrder() under the decision time limit and records how long it took
+        // in the given histogram. threads limits how many search threads the strategy may use, 0 for no limit.
+        void decide(Player* player, LatencyHistogram& latency, size_t threads = 0);
+        // Plays every card the player's strategy finds a target for. Cards go back to the shared deck,
+        // so this runs one player at a time.
+        void playCards(Player* player);
+
+        // Hands a new gameState to the players and subscribes the journal to it.
+        void attachGameState();
+
+        // Phases shared by the main loop and replay().
+        void reinforcementPhase();
+        void executeOrdersPhase();
+
+        // Appends to the journal, if one is open.
+        void record(const JournalRecord& record);
+        // Journals the orders issued since the order lists had the given sizes, and every pool.
+        void recordIssuedOrders(const std::vector<int>& listSizes);
+
+        std::unique_ptr<JournalWriter> journal;
+        std::optional<uint32_t> replaySeed;  // used by gamestart instead of a fresh seed while replaying
+        bool issuing = false;                // board changes while set are decisions, not order results
+
+        int decisionTimeMs;
+        std::mutex decisionMutex;           // guards decisionToken
+        CancellationToken decisionToken;    // replaced at the start of every issue-orders phase
+        // Per strategy name; entries are created before any decision starts and handed to decide(),
+        // so the phase never looks them up and concurrent record() calls only touch the atomics inside.
+        std::map<std::string, std::unique_ptr<LatencyHistogram>> decisionLatency;
+        // Threads the concurrent bots decide on, created for the first concurrent phase. Separate
+        // from ThreadPool::shared(), so a bot's own search can still fan out on the shared pool.
+        std::unique_ptr<ThreadPool> decisionPool;
 
 };
 void testGameStates();
+void testNeutralPlayer();
+void testConcurrentIssue();
+void testDecisionTime();
+void testJournalReplay();
+void testCheckpoint();
 
 
 #endif
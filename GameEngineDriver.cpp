@@ -6,10 +6,18 @@
 #include "Player.h"
 #include "Map.h"
 #include "Cards.h"
+#include "Orders.h"
+#include "Journal.h"
+#include "DriverCheck.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <thread>
 
 namespace {
 
@@ -24,6 +32,74 @@ std::string trim(const std::string& value)
     return value.substr(first, last - first + 1);
 }
 
+// Runs the startup commands on a fresh engine, the way a console or file would feed them.
+void startGame(GameEngine& engine, const std::vector<std::string>& commands)
+{
+    QueueCommandProcessor processor;
+    for (const std::string& command : commands)
+    {
+        processor.push(command);
+    }
+    processor.close();
+    engine.startupPhase(processor);
+}
+
+// Plays whole turns, ending each phase with a queued command instead of one typed at the console.
+void playTurns(GameEngine& engine, int turns)
+{
+    QueueCommandProcessor commands(2 * static_cast<size_t>(turns) + 1);
+    for (int i = 0; i < turns; ++i)
+    {
+        commands.push("endissueorders");
+        commands.push("endexecorders");
+    }
+    commands.close();
+    engine.mainGameLoop(commands);
+}
+
+// Owners, armies, pools, hand sizes, deck size and hash, for comparing two games.
+std::string position(const GameEngine& engine)
+{
+    std::ostringstream out;
+    for (const auto& node : engine.getLoadedMap()->getTerritoryNodes())
+    {
+        out << (node.owner ? node.owner->getName() : "-") << ':' << node.armies << ',';
+    }
+    for (const auto& player : engine.getPlayers())
+    {
+        out << player->getName() << ':' << player->getReinforcementPool() << '/' << player->getHand()->size() << ';';
+    }
+    out << engine.getGameState()->getDeck()->size() << '#' << engine.getGameState()->getHash();
+    return out.str();
+}
+
+std::string readBytes(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void writeBytes(const std::string& path, const std::string& bytes)
+{
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+}
+
+// True if loading the file throws std::runtime_error and leaves the engine's game as it was.
+bool rejectsCheckpoint(GameEngine& engine, const std::string& path)
+{
+    const std::string before = position(engine);
+    try
+    {
+        engine.loadCheckpoint(path);
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cout << "  rejected: " << e.what() << "\n";
+        return position(engine) == before;
+    }
+    return false;
+}
+
 }
 
 void testStartupPhase()
@@ -140,9 +216,346 @@ void testStartupPhase()
     std::cout << "=== End of Startup Summary ===\n";
 }
 
+void testNeutralPlayer()
+{
+    std::cout << "=== Neutral Player Driver ===\n";
+
+    GameEngine engine;
+    startGame(engine, {"loadmap Americas 1792", "validatemap", "addplayer Ann", "addplayer Bo", "gamestart"});
+    Player* attacker = engine.getPlayers()[0].get();
+    Player* neutral = engine.getPlayers()[1].get();
+    // Made neutral after gamestart, the way a strategy is picked in the middle of a game.
+    engine.assignStrategyToPlayer(1, "Neutral");
+    check(dynamic_cast<NeutralPlayerStrategy*>(neutral->getStrategy()) != nullptr, "Bo is neutral");
+
+    GameState& state = *engine.getGameState();
+    Map::territoryNode* source = nullptr;
+    Map::territoryNode* target = nullptr;
+    for (Map::territoryNode* owned : *attacker->getOwnedTerritories())
+    {
+        for (Map::territoryNode* neighbour : *neutral->getOwnedTerritories())
+        {
+            if (state.areAdjacent(owned, neighbour))
+            {
+                source = owned;
+                target = neighbour;
+                break;
+            }
+        }
+        if (source) break;
+    }
+    check(source != nullptr, "Ann borders a territory of Bo");
+
+    state.setArmies(source, 10);
+    Advance attack(10, source->name, target->name);
+    attack.setIssuer(attacker);
+    attack.execute(state);
+    check(dynamic_cast<AggressivePlayerStrategy*>(neutral->getStrategy()) != nullptr,
+          "Bo became aggressive after Ann attacked " + target->name);
+
+    std::cout << "=== End of Neutral Player Driver ===\n";
+}
+
+void testConcurrentIssue()
+{
+    std::cout << "=== Concurrent Issue Driver ===\n";
+
+    namespace fs = std::filesystem;
+    const std::string path = (fs::temp_directory_path() / "risk-driver-issue.ckp").string();
+
+    GameEngine concurrent;
+    startGame(concurrent, {"loadmap Americas 1792", "validatemap", "addplayer Ann", "addplayer Bo", "addplayer Cy", "gamestart"});
+    concurrent.assignStrategyToPlayer(0, "Aggressive");
+    concurrent.assignStrategyToPlayer(1, "Benevolent");
+    concurrent.assignStrategyToPlayer(2, "Aggressive");
+    concurrent.apply("issueorder");
+    concurrent.saveCheckpoint(path);
+
+    // The same position, decided one player after another without the engine.
+    GameEngine serial;
+    serial.loadCheckpoint(path);
+    fs::remove(path);
+    for (const auto& player : serial.getPlayers())
+    {
+        serial.getGameState()->setCurrentPlayer(player.get());
+        player->issueOrder();
+    }
+    for (const auto& player : serial.getPlayers())
+    {
+        for (int i = 0; i < CARD_TYPE_COUNT; ++i)
+        {
+            Card card(static_cast<CardType>(i));
+            while (player->getHand()->count(card.getType()) > 0 &&
+                   card.play(player.get(), serial.getGameState()->getDeck(), player->getHand()))
+            {
+            }
+        }
+    }
+
+    // Stops at the first prompt, right after the issue-orders phase.
+    playTurns(concurrent, 0);
+
+    const auto orders = [](const GameEngine& engine, size_t p)
+    {
+        std::vector<std::string> descriptions;
+        const OrdersList* list = engine.getPlayers()[p]->getOrdersList();
+        for (int i = 0; i < list->size(); ++i)
+        {
+            descriptions.push_back(list->getOrder(i)->getDescription());
+        }
+        return descriptions;
+    };
+    for (size_t p = 0; p < serial.getPlayers().size(); ++p)
+    {
+        const std::string name = serial.getPlayers()[p]->getName();
+        check(!orders(concurrent, p).empty() && orders(concurrent, p) == orders(serial, p),
+              name + "'s orders issued concurrently match a serial run");
+    }
+
+    std::cout << "=== End of Concurrent Issue Driver ===\n";
+}
+
+void testDecisionTime()
+{
+    std::cout << "=== Decision Time Driver ===\n";
+
+    GameEngine engine;
+    startGame(engine, {"loadmap Americas 1792", "validatemap", "addplayer Ann", "addplayer Bo", "gamestart"});
+    Player* bot = engine.getPlayers()[0].get();
+    // Budgets of its own that would never run out, so only the context can stop the search. Any
+    // finite time shows it stopped; the bound is loose so a busy machine doesn't fail the check.
+    bot->setStrategy(new MCTSPlayerStrategy(bot, 1 << 30, 1 << 30, 1));
+    const long long boundMs = 5000;
+    using Clock = std::chrono::steady_clock;
+    const auto elapsedMs = [](Clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+    };
+
+    int orders = bot->getOrdersList()->size();
+    auto start = Clock::now();
+    bot->issueOrder(DecisionContext::within(std::chrono::milliseconds(50)));
+    long long took = elapsedMs(start);
+    check(took < boundMs, "a 50 ms deadline stopped the search after " + std::to_string(took) + " ms");
+    check(bot->getOrdersList()->size() > orders, "the best orders found so far were issued");
+
+    bot->setReinforcementPool(10);
+    orders = bot->getOrdersList()->size();
+    CancellationToken token;
+    std::thread canceller([token] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        token.cancel();
+    });
+    start = Clock::now();
+    DecisionContext context;
+    context.token = token;
+    bot->issueOrder(context);
+    took = elapsedMs(start);
+    canceller.join();
+    check(took < boundMs, "cancelling from another thread stopped the search after " + std::to_string(took) + " ms");
+    check(bot->getOrdersList()->size() > orders, "the cancelled search still issued orders");
+
+    bot->setReinforcementPool(10);
+    start = Clock::now();
+    bot->issueOrder(context);
+    took = elapsedMs(start);
+    check(took < boundMs, "an already cancelled search returns at once (" + std::to_string(took) + " ms)");
+
+    std::cout << "=== End of Decision Time Driver ===\n";
+}
+
+void testJournalReplay()
+{
+    std::cout << "=== Journal Replay Driver ===\n";
+
+    namespace fs = std::filesystem;
+    const std::string path = (fs::temp_directory_path() / "risk-driver.jnl").string();
+    const std::string tampered = (fs::temp_directory_path() / "risk-driver-tampered.jnl").string();
+    fs::remove(path);
+    fs::remove(tampered);
+
+    std::string live;
+    {
+        GameEngine engine;
+        engine.startJournal(path);
+        startGame(engine, {"loadmap Americas 1792", "validatemap", "addplayer Ann", "addplayer Bo", "addplayer Cy", "gamestart"});
+        engine.assignStrategyToPlayer(0, "Aggressive");
+        engine.assignStrategyToPlayer(1, "Benevolent");
+        engine.assignStrategyToPlayer(2, "Aggressive");
+        playTurns(engine, 4);
+        engine.stopJournal();
+        live = position(engine);
+    }
+
+    {
+        GameEngine engine;
+        engine.replay(path);
+        check(position(engine) == live, "the replayed game ends in the live game's position");
+    }
+
+    // The same journal with one deploy changed enough to move its stack to another army bucket:
+    // the board stops matching the journaled hashes.
+    std::vector<JournalRecord> records = JournalReader::readAll(path);
+    const auto deploy = std::find_if(records.begin(), records.end(), [](const JournalRecord& r) {
+        return r.type == JournalRecordType::IssuedOrder && r.kind == static_cast<int32_t>(JournalOrderKind::Deploy);
+    });
+    check(deploy != records.end(), "the journal holds the issued orders");
+    deploy->value += 1000;
+    {
+        JournalWriter writer(tampered);
+        for (const JournalRecord& r : records)
+        {
+            writer.append(r);
+        }
+    }
+    bool diverged = false;
+    try
+    {
+        GameEngine engine;
+        engine.replay(tampered);
+    }
+    catch (const std::runtime_error& e)
+    {
+        diverged = std::string(e.what()).find("diverged") != std::string::npos;
+    }
+    check(diverged, "a journal whose orders were changed is rejected");
+
+    // A record cut short by a crash is dropped; everything before it still replays.
+    fs::resize_file(path, fs::file_size(path) - 3);
+    {
+        GameEngine engine;
+        engine.replay(path);
+        check(engine.getGameState() != nullptr, "a journal cut off mid-record replays up to the cut");
+    }
+
+    std::ofstream(tampered, std::ios::binary | std::ios::trunc) << "not a journal";
+    bool rejected = false;
+    try
+    {
+        GameEngine engine;
+        engine.replay(tampered);
+    }
+    catch (const std::runtime_error&)
+    {
+        rejected = true;
+    }
+    check(rejected, "a file that isn't a journal is rejected");
+
+    // Journaling a new game over an old journal starts it over; resuming appends to it.
+    const size_t recorded = JournalReader::readAll(path).size();
+    {
+        JournalOptions options;
+        options.resume = true;
+        JournalWriter writer(path, options);
+        writer.append(records.front());
+    }
+    check(JournalReader::readAll(path).size() == recorded + 1, "a resumed journal keeps its records");
+    {
+        GameEngine engine;
+        engine.startJournal(path);
+        engine.stopJournal();
+    }
+    check(JournalReader::readAll(path).empty(), "a new journal over an old one starts empty");
+
+    // Two games in one file can't be told apart, so the journal is refused rather than replayed as one.
+    {
+        JournalWriter writer(tampered);
+        for (int game = 0; game < 2; ++game)
+        {
+            for (const JournalRecord& r : records)
+            {
+                writer.append(r);
+            }
+        }
+    }
+    rejected = false;
+    try
+    {
+        GameEngine engine;
+        engine.replay(tampered);
+    }
+    catch (const std::runtime_error& e)
+    {
+        rejected = std::string(e.what()).find("more than one game") != std::string::npos;
+    }
+    check(rejected, "a journal holding two games is rejected");
+
+    fs::remove(path);
+    fs::remove(tampered);
+    std::cout << "=== End of Journal Replay Driver ===\n";
+}
+
+void testCheckpoint()
+{
+    std::cout << "=== Checkpoint Driver ===\n";
+
+    namespace fs = std::filesystem;
+    const std::string path = (fs::temp_directory_path() / "risk-driver.ckp").string();
+    const std::string copy = (fs::temp_directory_path() / "risk-driver-copy.ckp").string();
+    const std::string broken = (fs::temp_directory_path() / "risk-driver-broken.ckp").string();
+
+    GameEngine live;
+    startGame(live, {"loadmap Americas 1792", "validatemap", "addplayer Ann", "addplayer Bo", "addplayer Cy", "gamestart"});
+    live.assignStrategyToPlayer(0, "Aggressive");
+    live.assignStrategyToPlayer(1, "script:Strategies/Turtle.rules");
+    Player* cy = live.getPlayers()[2].get();
+    cy->setStrategy(new MCTSPlayerStrategy(cy, 200, 20, 1));
+    playTurns(live, 2);
+    live.saveCheckpoint(path);
+
+    GameEngine loaded;
+    loaded.loadCheckpoint(path);
+    check(position(loaded) == position(live), "the loaded game is in the saved position");
+    const auto* scripted = dynamic_cast<const ScriptedPlayerStrategy*>(loaded.getPlayers()[1]->getStrategy());
+    check(scripted && scripted->getScript().getName() == "Turtle", "the scripted player keeps its script");
+    const auto* mcts = dynamic_cast<const MCTSPlayerStrategy*>(loaded.getPlayers()[2]->getStrategy());
+    check(mcts && mcts->getIterationBudget() == 200 && mcts->getTimeBudget() == 20 && mcts->getThreads() == 1,
+          "the MCTS player keeps its budgets");
+    loaded.saveCheckpoint(copy);
+    check(readBytes(copy) == readBytes(path), "saving the loaded game writes the same bytes");
+
+    const std::string bytes = readBytes(path);
+    for (size_t cut : {bytes.size() - 1, bytes.size() / 2, size_t(10)})
+    {
+        writeBytes(broken, bytes.substr(0, cut));
+        check(rejectsCheckpoint(loaded, broken), "a checkpoint cut to " + std::to_string(cut) + " bytes is rejected");
+    }
+
+    // The territory count follows the magic, the version, the map path and its fingerprint.
+    std::string huge = bytes;
+    uint32_t pathLength = 0;
+    for (int b = 0; b < 4; ++b) pathLength |= static_cast<uint32_t>(static_cast<uint8_t>(huge[6 + b])) << (8 * b);
+    for (int b = 0; b < 4; ++b) huge[6 + 4 + pathLength + 8 + b] = '\xff';
+    writeBytes(broken, huge);
+    check(rejectsCheckpoint(loaded, broken), "a territory count larger than the file is rejected");
+
+    // The decision time follows the territory count and the engine state.
+    std::string instant = bytes;
+    for (int b = 0; b < 4; ++b) instant[6 + 4 + pathLength + 8 + 4 + 1 + b] = '\0';
+    writeBytes(broken, instant);
+    check(rejectsCheckpoint(loaded, broken), "a decision time below 1 ms is rejected");
+
+    std::string renamed = bytes;
+    const std::string name = "Aggressive";
+    const size_t strategy = renamed.find(name);
+    check(strategy != std::string::npos, "the checkpoint names Ann's strategy");
+    renamed[strategy + name.size() - 1] = 'x';
+    writeBytes(broken, renamed);
+    check(rejectsCheckpoint(loaded, broken), "a strategy that isn't registered is rejected, not replaced");
+
+    fs::remove(path);
+    fs::remove(copy);
+    fs::remove(broken);
+    std::cout << "=== End of Checkpoint Driver ===\n";
+}
+
 /**
 int main() {
 	testGameStates();
+	testNeutralPlayer();
+	testConcurrentIssue();
+	testDecisionTime();
+	testJournalReplay();
+	testCheckpoint();
 }
 */
 
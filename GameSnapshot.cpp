@@ -0,0 +1,108 @@
+//
+// GameSnapshot.cpp
+// Lightweight copy-on-write copy of a game's state for AI lookahead.
+//
+
+#include "GameSnapshot.h"
+
+GameSnapshot::GameSnapshot()
+    : map(nullptr), deck(std::make_shared<std::vector<uint8_t>>()), currentPlayer(-1), phase(-1), hash(0) {}
+
+GameSnapshot::GameSnapshot(const Map* map, int playerCount)
+    : map(map),
+      owners(map ? map->getTerritoryNodes().size() : 0, static_cast<int8_t>(-1)),
+      armies(map ? map->getTerritoryNodes().size() : 0, 0),
+      players(static_cast<size_t>(playerCount < 0 ? 0 : playerCount)),
+      deck(std::make_shared<std::vector<uint8_t>>()),
+      currentPlayer(-1),
+      phase(-1),
+      hash(0) {}
+
+int GameSnapshot::addPlayer() {
+    CowArray<PlayerData, 8> grown(players.size() + 1);
+    for (size_t p = 0; p < players.size(); ++p) grown.set(p, players[p]);
+    players = std::move(grown);
+    return playerCount() - 1;
+}
+
+void GameSnapshot::setOwner(int territory, int player) {
+    const int previous = owners[territory];
+    if (previous == player) return;
+    hash ^= Zobrist::ownerKey(territory, previous) ^ Zobrist::ownerKey(territory, player);
+    owners.set(territory, static_cast<int8_t>(player));
+}
+
+void GameSnapshot::setArmies(int territory, int count) {
+    if (count < 0) count = 0;
+    const int previous = armies[territory];
+    if (previous == count) return;
+    hash ^= Zobrist::armyKey(territory, previous) ^ Zobrist::armyKey(territory, count);
+    armies.set(territory, count);
+}
+
+void GameSnapshot::setCurrentPlayer(int player) {
+    hash ^= Zobrist::currentPlayerKey(currentPlayer) ^ Zobrist::currentPlayerKey(player);
+    currentPlayer = player;
+}
+
+void GameSnapshot::setPhase(int phase) {
+    hash ^= Zobrist::phaseKey(this->phase) ^ Zobrist::phaseKey(phase);
+    this->phase = phase;
+}
+
+uint64_t GameSnapshot::computeHash() const {
+    uint64_t h = Zobrist::currentPlayerKey(currentPlayer) ^ Zobrist::phaseKey(phase);
+    for (int t = 0; t < territoryCount(); ++t) {
+        h ^= Zobrist::ownerKey(t, owners[t]) ^ Zobrist::armyKey(t, armies[t]);
+    }
+    return h;
+}
+
+void GameSnapshot::setReinforcementPool(int player, int armies) {
+    PlayerData data = players[player];
+    data.reinforcementPool = armies < 0 ? 0 : armies;
+    players.set(player, data);
+}
+
+void GameSnapshot::setCardCount(int player, int cardType, int count) {
+    PlayerData data = players[player];
+    data.cards[cardType] = static_cast<uint8_t>(count < 0 ? 0 : (count > 255 ? 255 : count));
+    players.set(player, data);
+}
+
+std::vector<uint8_t>& GameSnapshot::mutableDeck() {
+    if (deck.use_count() != 1) {
+        deck = std::make_shared<std::vector<uint8_t>>(*deck);
+    }
+    return *deck;
+}
+
+void GameSnapshot::setDeck(std::vector<uint8_t> cards) {
+    deck = std::make_shared<std::vector<uint8_t>>(std::move(cards));
+}
+
+int GameSnapshot::takeDeckCard(size_t index) {
+    if (index >= deck->size()) return -1;
+    std::vector<uint8_t>& cards = mutableDeck();
+    const int card = cards[index];
+    cards[index] = cards.back();
+    cards.pop_back();
+    return card;
+}
+
+void GameSnapshot::returnDeckCard(int cardType) {
+    if (cardType < 0 || cardType >= CARD_TYPES) return;
+    mutableDeck().push_back(static_cast<uint8_t>(cardType));
+}
+
+int GameSnapshot::territoriesOwned(int player) const {
+    int count = 0;
+    for (int t = 0; t < territoryCount(); ++t) {
+        if (owners[t] == player) ++count;
+    }
+    return count;
+}
+
+bool GameSnapshot::sharesTerritoryPage(const GameSnapshot& other, int territory) const {
+    return owners.sharesPage(other.owners, territory) && armies.sharesPage(other.armies, territory);
+}
@@ -0,0 +1,116 @@
+//
+// GameSnapshot.h
+// Lightweight copy-on-write copy of a game's state for AI lookahead.
+//
+
+#ifndef COMP345_RISK_GAMESNAPSHOT_H
+#define COMP345_RISK_GAMESNAPSHOT_H
+
+#include "CowArray.h"
+#include "Map.h"
+#include "Zobrist.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Flat, index-based copy of everything that changes during a game: territory owners and
+ * armies, reinforcement pools, hands and the deck. Territories and players are identified by
+ * their index in the map and in GameState::getPlayers(); owner -1 means unowned.
+ *
+ * Snapshots are cheap to copy: territory and player arrays are CowArrays and the deck is shared
+ * until written, so forking a snapshot costs O(1) and applying changes costs O(changed pages).
+ * The map itself is shared and never modified through a snapshot.
+ */
+class GameSnapshot {
+public:
+    static constexpr int CARD_TYPES = 5;
+
+    struct PlayerData {
+        int reinforcementPool = 0;
+        std::array<uint8_t, CARD_TYPES> cards{};
+
+        bool operator==(const PlayerData& other) const {
+            return reinforcementPool == other.reinforcementPool && cards == other.cards;
+        }
+    };
+
+    GameSnapshot();
+    GameSnapshot(const Map* map, int playerCount);
+
+    const Map* getMap() const { return map; }
+    int territoryCount() const { return static_cast<int>(owners.size()); }
+    int playerCount() const { return static_cast<int>(players.size()); }
+
+    int getOwner(int territory) const { return owners[territory]; }
+    void setOwner(int territory, int player);
+
+    int getArmies(int territory) const { return armies[territory]; }
+    void setArmies(int territory, int count);
+
+    /**
+     * Player whose turn it is and the engine phase (a State value), -1 if unset.
+     */
+    int getCurrentPlayer() const { return currentPlayer; }
+    void setCurrentPlayer(int player);
+    int getPhase() const { return phase; }
+    void setPhase(int phase);
+
+    /**
+     * Zobrist hash over territory owners, army buckets, current player and phase (see Zobrist.h).
+     * Maintained incrementally by the setters above.
+     */
+    uint64_t getHash() const { return hash; }
+
+    /**
+     * Recomputes the hash from scratch in O(territories), to check the incremental one.
+     */
+    uint64_t computeHash() const;
+
+    int getReinforcementPool(int player) const { return players[player].reinforcementPool; }
+    void setReinforcementPool(int player, int armies);
+
+    int getCardCount(int player, int cardType) const { return players[player].cards[cardType]; }
+    void setCardCount(int player, int cardType, int count);
+    const PlayerData& getPlayer(int player) const { return players[player]; }
+    void setPlayer(int player, const PlayerData& data) { players.set(player, data); }
+
+    /**
+     * Appends a player with an empty pool and hand and returns its index. Copies the player array.
+     */
+    int addPlayer();
+
+    /**
+     * Deck contents as card type indices (see CardsUtil::validTypes()).
+     */
+    const std::vector<uint8_t>& getDeck() const { return *deck; }
+    void setDeck(std::vector<uint8_t> cards);
+    // Removes the card at the given position by swapping in the last one, like Deck::draw().
+    int takeDeckCard(size_t index);
+    void returnDeckCard(int cardType);
+
+    /**
+     * Number of territories owned by a player. O(territories).
+     */
+    int territoriesOwned(int player) const;
+
+    /**
+     * True if the two snapshots still share the page holding this territory's owner.
+     */
+    bool sharesTerritoryPage(const GameSnapshot& other, int territory) const;
+
+private:
+    const Map* map;
+    CowArray<int8_t> owners;
+    CowArray<int32_t> armies;
+    CowArray<PlayerData, 8> players;
+    std::shared_ptr<std::vector<uint8_t>> deck;
+    int currentPlayer;
+    int phase;
+    uint64_t hash;
+
+    std::vector<uint8_t>& mutableDeck();
+};
+
+#endif // COMP345_RISK_GAMESNAPSHOT_H
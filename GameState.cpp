@@ -0,0 +1,331 @@
+//
+// GameState.cpp
+// Mutable state of a running game shared by order execution.
+//
+
+#include "GameState.h"
+#include "Player.h"
+#include "Cards.h"
+#include "Orders.h"
+#include "GameEngine.h"
+#include "PlayerStrategies.h"
+#include <algorithm>
+#include <iostream>
+
+static_assert(GameSnapshot::CARD_TYPES == CARD_TYPE_COUNT, "snapshot hands are indexed by CardType");
+
+GameState::GameState(Map* map, const std::vector<Player*>& players, Deck* deck, uint32_t seed)
+    : map(map), deck(deck), players(players), combat(seed),
+      topology(map ? MapTopology::of(map) : std::make_shared<const MapTopology>(Map())),
+      mirror(map, static_cast<int>(players.size())),
+      influence(map, topology), revision(0),
+      journaling(false) {
+    resync();
+}
+
+GameState::~GameState() {}
+
+Map* GameState::getMap() const { return map; }
+Deck* GameState::getDeck() const { return deck; }
+const std::vector<Player*>& GameState::getPlayers() const { return players; }
+CombatKernel& GameState::getCombat() { return combat; }
+EventBus& GameState::getEvents() { return events; }
+
+void GameState::publish(const GameEvent& event) {
+    if (!journaling) events.publish(event);
+}
+
+Map::territoryNode* GameState::findTerritory(const std::string& name) const {
+    return map ? map->findTerritory(name) : nullptr;
+}
+
+int GameState::territoryId(const Map::territoryNode* territory) const {
+    return map ? map->indexOf(territory) : -1;
+}
+
+Player* GameState::findPlayer(const std::string& name) const {
+    for (Player* p : players) {
+        if (p && p->getName() == name) return p;
+    }
+    return nullptr;
+}
+
+int GameState::playerId(const Player* player) const {
+    auto it = std::find(players.begin(), players.end(), player);
+    return it == players.end() ? -1 : static_cast<int>(it - players.begin());
+}
+
+Player* GameState::getNeutralPlayer() {
+    for (Player* p : players) {
+        if (p && dynamic_cast<NeutralPlayerStrategy*>(p->getStrategy())) return p;
+    }
+
+    // One that was attacked turned aggressive and keeps its name, so later ones are numbered.
+    std::string name = "Neutral";
+    for (int n = 2; findPlayer(name); ++n) name = "Neutral " + std::to_string(n);
+    auto neutral = std::make_unique<Player>(name);
+    neutral->setStrategy(new NeutralPlayerStrategy(neutral.get()));
+    neutral->setGameState(this);
+    NeutralPlayerStrategy::watchForAttacks(neutral.get(), events);
+
+    players.push_back(neutral.get());
+    mirror.addPlayer();
+    if (frozen) frozen->addPlayer();
+    joined.push_back(std::move(neutral));
+    return players.back();
+}
+
+std::vector<std::unique_ptr<Player>> GameState::takeJoinedPlayers() {
+    std::vector<std::unique_ptr<Player>> taken;
+    taken.swap(joined);
+    return taken;
+}
+
+bool GameState::areAdjacent(const Map::territoryNode* a, const Map::territoryNode* b) const {
+    if (!a || !b) return false;
+    const int target = territoryId(b);
+    if (target < 0) return false;
+    return std::find(a->adjacentIndices.begin(), a->adjacentIndices.end(), target) != a->adjacentIndices.end();
+}
+
+bool GameState::bordersPlayer(const Map::territoryNode* territory, const Player* player) const {
+    if (!territory || !map) return false;
+    const auto& nodes = map->getTerritoryNodes();
+    for (int adj : territory->adjacentIndices) {
+        if (nodes[adj].owner == player) return true;
+    }
+    return false;
+}
+
+const std::vector<float>& GameState::getThreat(const Player* player) {
+    return influence.threat(player, revision);
+}
+
+void GameState::setArmies(Map::territoryNode* territory, int armies) {
+    if (!territory) return;
+    recordTerritory(territory);
+    ++revision;
+    territory->armies = std::max(0, armies);
+    const int id = territoryId(territory);
+    if (id >= 0) mirror.setArmies(id, territory->armies);
+}
+
+void GameState::setOwner(Map::territoryNode* territory, Player* owner) {
+    if (!territory || territory->owner == owner) return;
+    recordTerritory(territory);
+    ++revision;
+    if (territory->owner) territory->owner->removeTerritory(territory);
+    if (owner) {
+        owner->addTerritory(territory);
+    } else {
+        territory->owner = nullptr;
+    }
+    const int id = territoryId(territory);
+    if (id >= 0) mirror.setOwner(id, playerId(owner));
+}
+
+void GameState::setCurrentPlayer(const Player* player) {
+    mirror.setCurrentPlayer(playerId(player));
+}
+
+void GameState::setPhase(State phase) {
+    mirror.setPhase(static_cast<int>(phase));
+}
+
+void GameState::awardConquestCard(Player* player) {
+    if (!player || !deck) return;
+    if (!cardAwarded.insert(player).second) return;
+    UndoRecord awarded{};
+    awarded.kind = UndoRecord::CardAwarded;
+    awarded.index = playerId(player);
+    record(awarded);
+    if (auto card = deck->draw()) {
+        if (!player->addCard(*card)) {
+            deck->returnCard(*card);
+            return;
+        }
+        UndoRecord r{};
+        r.kind = UndoRecord::CardDrawn;
+        r.index = playerId(player);
+        r.value = static_cast<int32_t>(*card);
+        record(r);
+        publish(GameEvent{GameEventType::CardDrawn, player, nullptr, nullptr, *card});
+    }
+}
+
+bool GameState::hasConquestCard(const Player* player) const {
+    return cardAwarded.count(player) != 0;
+}
+
+void GameState::markConquestCard(const Player* player) {
+    if (player) cardAwarded.insert(player);
+}
+
+void GameState::setReinforcementPool(Player* player, int armies) {
+    if (!player) return;
+    const int before = player->getReinforcementPool();
+    player->setReinforcementPool(armies);
+    UndoRecord r{};
+    r.kind = UndoRecord::PoolChange;
+    r.index = playerId(player);
+    r.value = player->getReinforcementPool() - before;
+    if (r.value != 0) record(r);
+}
+
+void GameState::beginTurn() {
+    cardAwarded.clear();
+}
+
+GameSnapshot GameState::snapshot() const {
+    if (frozen) return *frozen;
+    GameSnapshot copy = mirror;
+
+    for (size_t p = 0; p < players.size(); ++p) {
+        GameSnapshot::PlayerData data;
+        data.reinforcementPool = players[p]->getReinforcementPool();
+        const auto& counts = players[p]->getHand()->getCounts();
+        std::copy(counts.begin(), counts.end(), data.cards.begin());
+        copy.setPlayer(static_cast<int>(p), data);
+    }
+
+    std::vector<uint8_t> deckCards;
+    if (deck) {
+        const auto& cards = deck->getCards();
+        deckCards.resize(cards.size());
+        std::transform(cards.begin(), cards.end(), deckCards.begin(),
+                       [](CardType type) { return static_cast<uint8_t>(type); });
+    }
+    copy.setDeck(std::move(deckCards));
+    return copy;
+}
+
+void GameState::freezeSnapshot() {
+    frozen.reset();
+    frozen = std::make_unique<GameSnapshot>(snapshot());
+}
+
+void GameState::thawSnapshot() {
+    frozen.reset();
+}
+
+void GameState::resync() {
+    if (!map) return;
+    ++revision;
+    const auto& nodes = map->getTerritoryNodes();
+    for (size_t t = 0; t < nodes.size(); ++t) {
+        mirror.setOwner(static_cast<int>(t), playerId(nodes[t].owner));
+        mirror.setArmies(static_cast<int>(t), nodes[t].armies);
+    }
+}
+
+void GameState::setJournaling(bool enabled) {
+    journaling = enabled;
+    if (!enabled) commit();
+}
+
+size_t GameState::journalMark() {
+    const size_t mark = journal.size();
+    if (!journaling) return mark;
+
+    SavedRandomness saved;
+    saved.lanes = combat.getLanes();
+    saved.deckRng = deck ? deck->getRngState() : 0;
+    if (deck) saved.deckCards = deck->getCards();
+    UndoRecord r{};
+    r.kind = UndoRecord::Mark;
+    r.index = static_cast<int32_t>(marks.size());
+    marks.push_back(std::move(saved));
+    journal.push_back(r);
+    return mark;
+}
+
+void GameState::commit() {
+    journal.clear();
+    marks.clear();
+}
+
+void GameState::record(const UndoRecord& r) {
+    if (journaling) journal.push_back(r);
+}
+
+void GameState::recordTerritory(const Map::territoryNode* territory) {
+    if (!journaling) return;
+    UndoRecord r{};
+    r.kind = UndoRecord::TerritoryChange;
+    r.index = territoryId(territory);
+    r.previousOwner = playerId(territory->owner);
+    r.value = territory->armies;
+    if (r.index >= 0) journal.push_back(r);
+}
+
+// Restores a territory without journaling; used by rollback().
+void GameState::writeTerritory(int id, int ownerId, int armies) {
+    Map::territoryNode* territory = &map->getTerritoryNodes()[id];
+    ++revision;
+    Player* owner = ownerId >= 0 ? players[ownerId] : nullptr;
+    if (territory->owner != owner) {
+        if (territory->owner) territory->owner->removeTerritory(territory);
+        if (owner) {
+            owner->addTerritory(territory);
+        } else {
+            territory->owner = nullptr;
+        }
+        mirror.setOwner(id, ownerId);
+    }
+    territory->armies = armies;
+    mirror.setArmies(id, armies);
+}
+
+void GameState::apply(Order* order) {
+    if (!order || order->isExecuted()) return;
+    UndoRecord r{};
+    r.kind = UndoRecord::OrderExecuted;
+    r.order = order;
+    record(r);
+    order->execute(*this);
+}
+
+void GameState::apply(Advance* order, const BattleOutcome& outcome) {
+    if (!order || order->isExecuted()) return;
+    UndoRecord r{};
+    r.kind = UndoRecord::OrderExecuted;
+    r.order = order;
+    record(r);
+    order->execute(*this, outcome);
+}
+
+void GameState::rollback(size_t mark) {
+    while (journal.size() > mark) {
+        const UndoRecord r = journal.back();
+        journal.pop_back();
+
+        switch (r.kind) {
+        case UndoRecord::TerritoryChange:
+            writeTerritory(r.index, r.previousOwner, r.value);
+            break;
+        case UndoRecord::PoolChange: {
+            Player* player = players[r.index];
+            player->setReinforcementPool(player->getReinforcementPool() - r.value);
+            break;
+        }
+        case UndoRecord::CardDrawn:
+            players[r.index]->getHand()->removeCard(static_cast<CardType>(r.value));
+            deck->returnCard(static_cast<CardType>(r.value));
+            break;
+        case UndoRecord::CardAwarded:
+            cardAwarded.erase(players[r.index]);
+            break;
+        case UndoRecord::OrderExecuted:
+            r.order->resetExecution();
+            break;
+        case UndoRecord::Mark: {
+            // Marks are rolled back newest first, so this is always the last saved one.
+            SavedRandomness& saved = marks[r.index];
+            combat.setLanes(saved.lanes);
+            if (deck) deck->restore(std::move(saved.deckCards), saved.deckRng);
+            marks.pop_back();
+            break;
+        }
+        }
+    }
+}
@@ -0,0 +1,230 @@
+//
+// GameState.h
+// Mutable state of a running game shared by order execution.
+//
+
+#ifndef COMP345_RISK_GAMESTATE_H
+#define COMP345_RISK_GAMESTATE_H
+
+#include "Map.h"
+#include "Battle.h"
+#include "EventBus.h"
+#include "GameSnapshot.h"
+#include "InfluenceMap.h"
+#include "MapTopology.h"
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+class Player;
+class Deck;
+class Card;
+class Order;
+class Advance;
+enum class State;
+enum class CardType : uint8_t;
+
+/**
+ * Everything orders need to execute against: the map, the players and the deck.
+ * The engine owns the underlying objects; GameState only points at them.
+ *
+ * Order execution goes through the mutators below rather than writing to territories
+ * directly, so ownership changes keep the players' territory lists in sync.
+ */
+class GameState {
+public:
+    GameState(Map* map, const std::vector<Player*>& players, Deck* deck, uint32_t seed);
+    GameState(const GameState& other) = delete;
+    GameState& operator=(const GameState& other) = delete;
+    ~GameState();
+
+    Map* getMap() const;
+    Deck* getDeck() const;
+    const std::vector<Player*>& getPlayers() const;
+    CombatKernel& getCombat();
+
+    /**
+     * Immutable adjacency and continent data of the map, shared with every other game on it.
+     */
+    const MapTopology& getTopology() const { return *topology; }
+    EventBus& getEvents();
+
+    /**
+     * Delivers an event to subscribers. Nothing is published while journaling, since journaled
+     * changes are speculative and may be rolled back.
+     */
+    void publish(const GameEvent& event);
+
+    /**
+     * Territory lookups. Return nullptr / -1 if the name or node is not on the map.
+     */
+    Map::territoryNode* findTerritory(const std::string& name) const;
+    int territoryId(const Map::territoryNode* territory) const;
+
+    /**
+     * Player lookups. Return nullptr / -1 if the player is not in this game.
+     */
+    Player* findPlayer(const std::string& name) const;
+    int playerId(const Player* player) const;
+
+    /**
+     * The player blockaded territories are handed to: the first player with the Neutral strategy,
+     * or a new one appended to the players on first use. A created player is kept, even through a
+     * rollback, and owned by the game state until the engine adopts it with takeJoinedPlayers().
+     */
+    Player* getNeutralPlayer();
+    std::vector<std::unique_ptr<Player>> takeJoinedPlayers();
+
+    bool areAdjacent(const Map::territoryNode* a, const Map::territoryNode* b) const;
+
+    /**
+     * True if the player owns at least one territory adjacent to the given one.
+     */
+    bool bordersPlayer(const Map::territoryNode* territory, const Player* player) const;
+
+    /**
+     * Enemy pressure on every territory id as seen by the player; see InfluenceMap.
+     * Computed at most once per player until a territory changes owner or armies.
+     */
+    const std::vector<float>& getThreat(const Player* player);
+
+    /**
+     * Bumped by every change to a territory's owner or armies.
+     */
+    uint64_t getRevision() const { return revision; }
+
+    // Mutators used by order execution. Each one is journaled while journaling is on.
+    void setArmies(Map::territoryNode* territory, int armies);
+    void setOwner(Map::territoryNode* territory, Player* owner);
+    void setReinforcementPool(Player* player, int armies);
+
+    /**
+     * Whose turn it is and which engine phase the game is in. Both are part of the position hash.
+     */
+    void setCurrentPlayer(const Player* player);
+    void setPhase(State phase);
+
+    /**
+     * 64-bit Zobrist hash of the current position, maintained incrementally by the mutators.
+     * Usable as a transposition table key and as a cheap checksum when verifying replays.
+     */
+    uint64_t getHash() const { return mirror.getHash(); }
+
+    /**
+     * Draws a card for a player who conquered a territory. A player earns at most one card per turn.
+     */
+    void awardConquestCard(Player* player);
+
+    /**
+     * Whether the player already drew their conquest card this turn. Checkpoints save and restore it.
+     */
+    bool hasConquestCard(const Player* player) const;
+    void markConquestCard(const Player* player);
+
+    /**
+     * Resets per-turn bookkeeping. Called by the engine before orders are executed.
+     */
+    void beginTurn();
+
+    /**
+     * Executes an order against this state. While journaling is on, every change it makes
+     * is recorded so rollback() can revert it.
+     */
+    void apply(Order* order);
+
+    /**
+     * Executes an attacking Advance with a battle outcome resolved ahead of time, journaled like apply().
+     */
+    void apply(Advance* order, const BattleOutcome& outcome);
+
+    /**
+     * Reverts every change journaled since the given mark, newest first, in O(changes).
+     * Reverted orders are marked as not executed so they can be applied again.
+     */
+    void rollback(size_t mark);
+
+    /**
+     * Position in the journal to roll back to later. While journaling, the combat lanes and the
+     * deck's cards and generator are saved here too, so rolling back to the mark and applying the
+     * same orders again rolls the same battles and draws the same cards.
+     */
+    size_t journalMark();
+
+    /**
+     * Forgets the journal without reverting anything.
+     */
+    void commit();
+
+    void setJournaling(bool enabled);
+    bool isJournaling() const { return journaling; }
+
+    /**
+     * Copy-on-write copy of the current state for lookahead.
+     * Territory arrays are kept up to date by the mutators above, so this only copies page
+     * pointers plus the per-player pools, hands and the deck.
+     */
+    GameSnapshot snapshot() const;
+
+    /**
+     * Pins snapshot() to the current position until thawSnapshot(). While pinned, snapshot() doesn't
+     * read the players at all, so strategies on several threads can take snapshots while each
+     * spends its own reinforcement pool.
+     */
+    void freezeSnapshot();
+    void thawSnapshot();
+
+    /**
+     * Rebuilds the territory mirror from the map, for changes made without going through GameState.
+     */
+    void resync();
+
+private:
+    // One journaled change. Territory changes keep the whole previous value so undoing
+    // doesn't depend on what happened in between.
+    struct UndoRecord {
+        enum Kind : uint8_t { TerritoryChange, PoolChange, CardDrawn, CardAwarded, OrderExecuted, Mark };
+        Kind kind;
+        int32_t index;          // territory id, player id, or index into marks
+        int32_t previousOwner;  // player id, TerritoryChange only
+        int32_t value;          // previous armies, pool delta, or CardType drawn
+        Order* order;           // OrderExecuted only
+    };
+
+    // Random state saved by journalMark().
+    struct SavedRandomness {
+        std::array<uint32_t, CombatKernel::LANES> lanes;
+        std::vector<CardType> deckCards;
+        uint32_t deckRng;
+    };
+
+    void record(const UndoRecord& r);
+    void recordTerritory(const Map::territoryNode* territory);
+    void writeTerritory(int id, int ownerId, int armies);
+
+    Map* map;
+    Deck* deck;
+    std::vector<Player*> players;
+    // Players created by getNeutralPlayer() that the engine hasn't adopted yet.
+    std::vector<std::unique_ptr<Player>> joined;
+    CombatKernel combat;
+    EventBus events;
+    std::unordered_set<const Player*> cardAwarded;
+    // Adjacency and continents of the map, shared with every other game on the same Map.
+    std::shared_ptr<const MapTopology> topology;
+    // Index-based copy of territory owners and armies, shared with snapshots page by page.
+    GameSnapshot mirror;
+    std::unique_ptr<GameSnapshot> frozen;
+    InfluenceMap influence;
+    uint64_t revision;
+    std::vector<UndoRecord> journal;
+    std::vector<SavedRandomness> marks;
+    bool journaling;
+};
+
+void testGameSnapshots();
+void testUndoJournal();
+void testZobristHash();
+
+#endif // COMP345_RISK_GAMESTATE_H
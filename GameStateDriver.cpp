@@ -0,0 +1,206 @@
+//
+// GameStateDriver.cpp
+// Driver for snapshots, the undo journal and position hashing on GameState.
+//
+
+#include "GameState.h"
+#include "GameEngine.h"
+#include "MapLoader.h"
+#include "Player.h"
+#include "Cards.h"
+#include "Orders.h"
+#include "DriverCheck.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Two players on a real map, territories dealt alternately with 5 armies each.
+struct DriverGame {
+    Map map;
+    Player ann{"Ann"};
+    Player bo{"Bo"};
+    Deck deck{20, 345};
+    std::unique_ptr<GameState> state;
+
+    DriverGame() : map(MapLoader("Maps/Americas 1792.map").getMap()) {
+        auto& nodes = map.getTerritoryNodes();
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            (i % 2 == 0 ? ann : bo).addTerritory(&nodes[i]);
+            nodes[i].armies = 5;
+        }
+        state = std::make_unique<GameState>(&map, std::vector<Player*>{&ann, &bo}, &deck, 345);
+    }
+
+    // Owners, armies, pools, hands and deck size, for comparing positions.
+    std::vector<int> board() const {
+        std::vector<int> values;
+        for (const auto& node : map.getTerritoryNodes()) {
+            values.push_back(node.owner == &ann ? 0 : node.owner == &bo ? 1 : -1);
+            values.push_back(node.armies);
+        }
+        for (const Player* player : {&ann, &bo}) {
+            values.push_back(player->getReinforcementPool());
+            values.push_back(static_cast<int>(player->getHand()->size()));
+        }
+        values.push_back(static_cast<int>(deck.size()));
+        return values;
+    }
+};
+
+}
+
+void testGameSnapshots() {
+    std::cout << "=== Game Snapshot Driver ===\n";
+
+    DriverGame game;
+    GameState& state = *game.state;
+    auto& nodes = game.map.getTerritoryNodes();
+    const int last = static_cast<int>(nodes.size()) - 1;
+
+    const GameSnapshot before = state.snapshot();
+    check(before.getHash() == state.getHash() && before.getOwner(0) == 0 && before.getArmies(0) == 5,
+          "a snapshot matches the board it was taken from");
+
+    GameSnapshot fork = before;
+    fork.setArmies(0, 99);
+    fork.setOwner(0, 1);
+    check(before.getArmies(0) == 5 && before.getOwner(0) == 0 && nodes[0].armies == 5 && nodes[0].owner == &game.ann,
+          "writing to a fork leaves the snapshot and the board alone");
+    check(!fork.sharesTerritoryPage(before, 0) && fork.sharesTerritoryPage(before, last),
+          "the fork copied only the page it wrote");
+
+    state.setArmies(&nodes[last], 42);
+    check(before.getArmies(last) == 5 && fork.getArmies(last) == 5 && state.snapshot().getArmies(last) == 42,
+          "later changes to the board don't reach earlier snapshots");
+
+    std::cout << "=== End of Game Snapshot Driver ===\n";
+}
+
+void testUndoJournal() {
+    std::cout << "=== Undo Journal Driver ===\n";
+
+    DriverGame game;
+    GameState& state = *game.state;
+    Map::territoryNode* source = nullptr;
+    Map::territoryNode* target = nullptr;
+    for (Map::territoryNode* owned : *game.ann.getOwnedTerritories()) {
+        for (Map::territoryNode* other : *game.bo.getOwnedTerritories()) {
+            if (state.areAdjacent(owned, other)) {
+                source = owned;
+                target = other;
+                break;
+            }
+        }
+        if (source) break;
+    }
+    check(source != nullptr, "Ann borders a territory of Bo");
+
+    const std::vector<int> before = game.board();
+    const uint64_t hash = state.getHash();
+
+    Deploy deploy(30, source->name);
+    Advance advance(34, source->name, target->name);
+    deploy.setIssuer(&game.ann);
+    advance.setIssuer(&game.ann);
+
+    state.setJournaling(true);
+    const size_t mark = state.journalMark();
+    state.apply(&deploy);
+    state.apply(&advance);
+    check(game.board() != before && target->owner == &game.ann && game.ann.getHand()->size() == 1,
+          "the orders conquered " + target->name + " and drew a card");
+    const std::vector<int> conquered = game.board();
+    const std::vector<CardType> deckAfter = game.deck.getCards();
+    const auto handAfter = game.ann.getHand()->getCounts();
+
+    state.rollback(mark);
+    check(game.board() == before && state.getHash() == hash, "rollback restores the board, the hands and the deck");
+    const auto* boTerritories = game.bo.getOwnedTerritories();
+    check(target->owner == &game.bo && std::count(boTerritories->begin(), boTerritories->end(), target) == 1,
+          "the territory is back on Bo's list");
+    check(!deploy.isExecuted() && !advance.isExecuted(), "rolled back orders can be executed again");
+
+    state.apply(&deploy);
+    state.apply(&advance);
+    check(game.board() == conquered && game.deck.getCards() == deckAfter && game.ann.getHand()->getCounts() == handAfter,
+          "applying the same orders again rolls the same battle and draws the same card");
+    state.setJournaling(false);
+
+    // With the deck empty no card is drawn, but the player still used up this turn's card.
+    DriverGame empty;
+    while (empty.deck.draw()) {}
+    auto& emptyNodes = empty.map.getTerritoryNodes();
+    Map::territoryNode* from = &emptyNodes[state.territoryId(source)];
+    Map::territoryNode* to = &emptyNodes[state.territoryId(target)];
+    Deploy reinforce(30, from->name);
+    Advance attack(34, from->name, to->name);
+    reinforce.setIssuer(&empty.ann);
+    attack.setIssuer(&empty.ann);
+    empty.state->setJournaling(true);
+    const size_t emptyMark = empty.state->journalMark();
+    empty.state->apply(&reinforce);
+    empty.state->apply(&attack);
+    const bool awarded = empty.state->hasConquestCard(&empty.ann);
+    empty.state->rollback(emptyMark);
+    empty.state->setJournaling(false);
+    check(awarded && !empty.state->hasConquestCard(&empty.ann),
+          "rollback gives back a conquest card that an empty deck couldn't pay out");
+
+    std::cout << "=== End of Undo Journal Driver ===\n";
+}
+
+void testZobristHash() {
+    std::cout << "=== Zobrist Hash Driver ===\n";
+
+    DriverGame game;
+    GameState& state = *game.state;
+    auto& nodes = game.map.getTerritoryNodes();
+    Player* players[] = {&game.ann, &game.bo};
+    const State phases[] = {State::AssignReinforcement, State::IssueOrders, State::ExecuteOrders};
+
+    // Random changes through every mutator that feeds the hash; the incremental hash must match
+    // a full recomputation after each one.
+    std::mt19937 rng(345);
+    const uint64_t start = state.getHash();
+    bool matches = true;
+    for (int step = 0; step < 20000 && matches; ++step) {
+        Map::territoryNode* territory = &nodes[rng() % nodes.size()];
+        switch (rng() % 4) {
+        case 0: state.setArmies(territory, static_cast<int>(rng() % 300)); break;
+        case 1: state.setOwner(territory, players[rng() % 2]); break;
+        case 2: state.setCurrentPlayer(rng() % 3 == 0 ? nullptr : players[rng() % 2]); break;
+        default: state.setPhase(phases[rng() % 3]); break;
+        }
+        matches = state.getHash() == state.snapshot().computeHash();
+    }
+    check(matches, "the incremental hash matches computeHash() after 20000 random changes");
+    check(state.getHash() != start, "a changed position hashes differently");
+
+    // The same position reached in a different order hashes the same.
+    DriverGame first, second;
+    auto& a = first.map.getTerritoryNodes();
+    auto& b = second.map.getTerritoryNodes();
+    first.state->setArmies(&a[0], 17);
+    first.state->setOwner(&a[1], &first.ann);
+    second.state->setOwner(&b[1], &second.ann);
+    second.state->setArmies(&b[0], 17);
+    check(first.state->getHash() == second.state->getHash(), "move order doesn't change the hash");
+    second.state->setArmies(&b[0], 5);
+    second.state->setArmies(&b[0], 17);
+    check(first.state->getHash() == second.state->getHash(), "a change and its reverse leave the hash where it was");
+
+    std::cout << "=== End of Zobrist Hash Driver ===\n";
+}
+
+/**
+int main() {
+    testGameSnapshots();
+    testUndoJournal();
+    testZobristHash();
+    return 0;
+}
+ */
@@ -0,0 +1,61 @@
+//
+// InfluenceMap.cpp
+// Per-territory enemy pressure shared by the bot strategies.
+//
+
+#include "InfluenceMap.h"
+
+InfluenceMap::InfluenceMap(const Map* map, std::shared_ptr<const MapTopology> topology)
+    : map(map), topology(std::move(topology)), cachedRevision(0) {}
+
+const std::vector<float>& InfluenceMap::threat(const Player* player, uint64_t revision) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (revision != cachedRevision) {
+        // Keep the buffers, just mark them stale by dropping the owners.
+        for (auto& entry : cache) entry.first = nullptr;
+        cachedRevision = revision;
+    }
+    for (auto& entry : cache) {
+        if (entry.first == player) return *entry.second;
+    }
+    for (auto& entry : cache) {
+        if (!entry.first) {
+            entry.first = player;
+            compute(player, *entry.second);
+            return *entry.second;
+        }
+    }
+    cache.emplace_back(player, std::make_unique<std::vector<float>>());
+    compute(player, *cache.back().second);
+    return *cache.back().second;
+}
+
+void InfluenceMap::multiply(const float* in, float* out) const {
+    const size_t count = territoryCount();
+    const int* start = topology->getRowStart().data();
+    const int* cols = topology->getColumns().data();
+    for (size_t t = 0; t < count; ++t) {
+        float sum = 0.0f;
+        for (int k = start[t]; k < start[t + 1]; ++k) {
+            sum += in[cols[k]];
+        }
+        out[t] = sum;
+    }
+}
+
+void InfluenceMap::compute(const Player* player, std::vector<float>& result) const {
+    const size_t count = territoryCount();
+    result.assign(count, 0.0f);
+    if (count == 0) return;
+    const auto& nodes = map->getTerritoryNodes();
+
+    std::vector<float> hostile(count), spread(count);
+    for (size_t t = 0; t < count; ++t) {
+        hostile[t] = (nodes[t].owner && nodes[t].owner != player) ? static_cast<float>(nodes[t].armies) : 0.0f;
+    }
+    multiply(hostile.data(), result.data());
+    multiply(result.data(), spread.data());
+    for (size_t t = 0; t < count; ++t) {
+        result[t] += HOP_DECAY * spread[t];
+    }
+}
@@ -0,0 +1,67 @@
+//
+// InfluenceMap.h
+// Per-territory enemy pressure shared by the bot strategies.
+//
+
+#ifndef COMP345_RISK_INFLUENCEMAP_H
+#define COMP345_RISK_INFLUENCEMAP_H
+
+#include "Map.h"
+#include "MapTopology.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+class Player;
+
+/**
+ * Enemy pressure on every territory, as seen by one player:
+ *
+ *     threat = A e + HOP_DECAY * A (A e)
+ *
+ * where A is the adjacency matrix and e holds the armies of territories owned by someone else
+ * (unowned territories count as empty). The first term is the hostile armies next to a territory,
+ * the second spreads them one more hop at a discount.
+ *
+ * The adjacency comes from the map's shared MapTopology in CSR form, so each product is one pass
+ * over the edges with plain float arrays. Results are cached per player and reused until the
+ * territories change, so every strategy of every player shares at most one computation per
+ * player per turn.
+ * threat() is safe to call from several threads; the returned reference stays valid until
+ * a later call sees a newer revision.
+ */
+class InfluenceMap {
+public:
+    static constexpr float HOP_DECAY = 0.5f;
+
+    InfluenceMap(const Map* map, std::shared_ptr<const MapTopology> topology);
+    InfluenceMap(const InfluenceMap& other) = delete;
+    InfluenceMap& operator=(const InfluenceMap& other) = delete;
+
+    /**
+     * Pressure on each territory id for the given player, recomputed if the territories changed
+     * since the cached revision.
+     */
+    const std::vector<float>& threat(const Player* player, uint64_t revision);
+
+    size_t territoryCount() const { return topology ? topology->territoryCount() : 0; }
+
+private:
+    const Map* map;
+    std::shared_ptr<const MapTopology> topology;
+
+    std::mutex mutex;
+    uint64_t cachedRevision;
+    // One slot per player asked about this revision; unique_ptr keeps returned references stable.
+    std::vector<std::pair<const Player*, std::unique_ptr<std::vector<float>>>> cache;
+
+    // out = A * in
+    void multiply(const float* in, float* out) const;
+    void compute(const Player* player, std::vector<float>& result) const;
+};
+
+void testInfluenceMap();
+
+#endif // COMP345_RISK_INFLUENCEMAP_H
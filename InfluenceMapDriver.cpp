@@ -0,0 +1,78 @@
+//
+// InfluenceMapDriver.cpp
+// Driver for the per-turn influence map.
+//
+
+#include "InfluenceMap.h"
+#include "MapLoader.h"
+#include "Player.h"
+#include "DriverCheck.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+// threat = A e + HOP_DECAY * A (A e), straight from the territories' adjacency lists.
+std::vector<float> expectedThreat(const Map& map, const Player* player) {
+    const auto& nodes = map.getTerritoryNodes();
+    std::vector<float> direct(nodes.size(), 0.0f);
+    for (size_t t = 0; t < nodes.size(); ++t) {
+        for (int adj : nodes[t].adjacentIndices) {
+            if (nodes[adj].owner && nodes[adj].owner != player) direct[t] += static_cast<float>(nodes[adj].armies);
+        }
+    }
+    std::vector<float> threat(direct);
+    for (size_t t = 0; t < nodes.size(); ++t) {
+        for (int adj : nodes[t].adjacentIndices) threat[t] += InfluenceMap::HOP_DECAY * direct[adj];
+    }
+    return threat;
+}
+
+bool near(const std::vector<float>& a, const std::vector<float>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (std::fabs(a[i] - b[i]) > 1e-3f * (1.0f + std::fabs(b[i]))) return false;
+    }
+    return true;
+}
+
+}
+
+void testInfluenceMap() {
+    std::cout << "=== Influence Map Driver ===\n";
+
+    Map map = MapLoader("Maps/Americas 1792.map").getMap();
+    Player ann("Ann");
+    Player bo("Bo");
+    auto& nodes = map.getTerritoryNodes();
+    // Every third territory stays unowned, and counts as empty.
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (i % 3 == 2) continue;
+        (i % 3 == 0 ? ann : bo).addTerritory(&nodes[i]);
+        nodes[i].armies = static_cast<int>(i % 7) + 1;
+    }
+
+    InfluenceMap influence(&map, MapTopology::of(&map));
+    const std::vector<float>& annThreat = influence.threat(&ann, 1);
+    check(near(annThreat, expectedThreat(map, &ann)), "Ann's threat matches A e + HOP_DECAY * A (A e)");
+    check(near(influence.threat(&bo, 1), expectedThreat(map, &bo)), "Bo's threat is computed from Bo's side");
+    check(&influence.threat(&ann, 1) == &annThreat, "asking again in the same revision returns the cached values");
+
+    // Territory 1 is Bo's, so more armies on it raise Ann's threat next to it.
+    nodes[1].armies += 100;
+    const int neighbour = nodes[1].adjacentIndices.front();
+    const float before = annThreat[neighbour];
+    check(influence.threat(&ann, 1)[neighbour] == before, "the cache holds until the revision changes");
+    const std::vector<float>& after = influence.threat(&ann, 2);
+    check(after[neighbour] > before && near(after, expectedThreat(map, &ann)), "a new revision recomputes");
+
+    std::cout << "=== End of Influence Map Driver ===\n";
+}
+
+/**
+int main() {
+    testInfluenceMap();
+    return 0;
+}
+ */
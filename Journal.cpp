@@ -0,0 +1,224 @@
+//
+// Journal.cpp
+// Append-only binary log of a game's commands and orders, for crash recovery and replays.
+//
+
+#include "Journal.h"
+#include "BinaryIO.h"
+#include "Orders.h"
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char MAGIC[4] = {'R', 'J', 'N', 'L'};
+constexpr size_t HEADER_SIZE = sizeof(MAGIC) + sizeof(uint16_t);
+
+#ifdef _WIN32
+int openFile(const std::string& path) { return _open(path.c_str(), _O_RDWR | _O_CREAT | _O_APPEND | _O_BINARY, 0644); }
+long writeFile(int fd, const char* data, size_t size) { return _write(fd, data, static_cast<unsigned>(size)); }
+void syncFile(int fd) { _commit(fd); }
+void closeFile(int fd) { _close(fd); }
+long fileSize(int fd) { return _lseek(fd, 0, SEEK_END); }
+bool truncateFile(int fd, long size) { return _chsize(fd, size) == 0; }
+#else
+int openFile(const std::string& path) { return ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644); }
+long writeFile(int fd, const char* data, size_t size) { return ::write(fd, data, size); }
+void syncFile(int fd) { ::fsync(fd); }
+void closeFile(int fd) { ::close(fd); }
+long fileSize(int fd) { return ::lseek(fd, 0, SEEK_END); }
+bool truncateFile(int fd, long size) { return ::ftruncate(fd, size) == 0; }
+#endif
+
+std::vector<char> readFileData(const std::string& path) {
+    std::vector<char> data;
+    if (!readFileBytes(path, data)) {
+        throw std::runtime_error("Could not read journal: " + path);
+    }
+    return data;
+}
+
+// Checks the header and decodes the records into out (if given). Returns where the last whole record ends.
+size_t parse(const std::vector<char>& data, const std::string& path, std::vector<JournalRecord>* out) {
+    if (data.size() < HEADER_SIZE || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a journal: " + path);
+    }
+    const uint16_t version = ByteReader(data.data() + sizeof(MAGIC), 2).u16();
+    if (version != JournalWriter::VERSION) {
+        throw std::runtime_error("Unsupported journal version " + std::to_string(version) + ": " + path);
+    }
+
+    size_t pos = HEADER_SIZE;
+    while (data.size() - pos >= 4) {
+        ByteReader length(data.data() + pos, 4);
+        const size_t size = length.u32();
+        if (data.size() - pos - 4 < size) break;  // torn write at the tail
+        ByteReader in(data.data() + pos + 4, size);
+        JournalRecord record;
+        record.type = static_cast<JournalRecordType>(in.u8());
+        record.player = in.i32();
+        record.kind = in.i32();
+        record.value = in.i32();
+        record.first = in.str();
+        record.second = in.str();
+        if (!in.ok()) break;
+        if (out) out->push_back(std::move(record));
+        pos += 4 + size;
+    }
+    return pos;
+}
+
+}
+
+JournalRecord JournalRecord::fromOrder(int player, const Order& order) {
+    JournalRecord record;
+    record.type = JournalRecordType::IssuedOrder;
+    record.player = player;
+    if (auto* deploy = dynamic_cast<const Deploy*>(&order)) {
+        record.kind = static_cast<int32_t>(JournalOrderKind::Deploy);
+        record.value = deploy->getArmyUnits();
+        record.first = deploy->getTargetTerritory();
+    } else if (auto* advance = dynamic_cast<const Advance*>(&order)) {
+        record.kind = static_cast<int32_t>(JournalOrderKind::Advance);
+        record.value = advance->getArmyUnits();
+        record.first = advance->getSourceTerritory();
+        record.second = advance->getTargetTerritory();
+    } else if (auto* bomb = dynamic_cast<const Bomb*>(&order)) {
+        record.kind = static_cast<int32_t>(JournalOrderKind::Bomb);
+        record.first = bomb->getTargetTerritory();
+    } else if (auto* blockade = dynamic_cast<const Blockade*>(&order)) {
+        record.kind = static_cast<int32_t>(JournalOrderKind::Blockade);
+        record.first = blockade->getTargetTerritory();
+    } else if (auto* airlift = dynamic_cast<const Airlift*>(&order)) {
+        record.kind = static_cast<int32_t>(JournalOrderKind::Airlift);
+        record.value = airlift->getArmyUnits();
+        record.first = airlift->getSourceTerritory();
+        record.second = airlift->getTargetTerritory();
+    } else if (auto* negotiate = dynamic_cast<const Negotiate*>(&order)) {
+        record.kind = static_cast<int32_t>(JournalOrderKind::Negotiate);
+        record.first = negotiate->getTargetPlayer();
+    }
+    return record;
+}
+
+Order* JournalRecord::toOrder() const {
+    if (type != JournalRecordType::IssuedOrder) return nullptr;
+    switch (static_cast<JournalOrderKind>(kind)) {
+        case JournalOrderKind::Deploy: return new Deploy(value, first);
+        case JournalOrderKind::Advance: return new Advance(value, first, second);
+        case JournalOrderKind::Bomb: return new Bomb(first);
+        case JournalOrderKind::Blockade: return new Blockade(first);
+        case JournalOrderKind::Airlift: return new Airlift(value, first, second);
+        case JournalOrderKind::Negotiate: return new Negotiate(first);
+    }
+    return nullptr;
+}
+
+JournalWriter::JournalWriter(const std::string& path, JournalOptions options)
+    : path(path), options(options), fd(openFile(path)), unsynced(0) {
+    if (fd < 0) {
+        throw std::runtime_error("Could not open journal: " + path);
+    }
+    buffer.reserve(BLOCK_SIZE);
+
+    long existing = fileSize(fd);
+    if (existing > 0 && !options.resume) {
+        if (!truncateFile(fd, 0)) {
+            closeFile(fd);
+            throw std::runtime_error("Could not start journal over: " + path);
+        }
+        existing = 0;
+    }
+    if (existing == 0) {
+        ByteWriter out(buffer);
+        out.bytes(MAGIC, sizeof(MAGIC));
+        out.u16(VERSION);
+        flush();
+        return;
+    }
+
+    // Appending to an earlier journal: drop a record torn by a crash so new ones follow the last whole one.
+    try {
+        const long end = static_cast<long>(parse(readFileData(path), path, nullptr));
+        if (end < existing && !truncateFile(fd, end)) {
+            throw std::runtime_error("Could not repair journal: " + path);
+        }
+    } catch (...) {
+        closeFile(fd);
+        throw;
+    }
+}
+
+JournalWriter::~JournalWriter() {
+    try {
+        flush();
+    } catch (const std::exception&) {
+        // Nothing left to report to; whatever reached the file stays readable.
+    }
+    if (options.sync != JournalOptions::Sync::None) syncFile(fd);
+    closeFile(fd);
+}
+
+void JournalWriter::append(const JournalRecord& record) {
+    ByteWriter out(buffer);
+    const size_t start = out.size();
+    out.u32(0);  // length, filled in below
+    out.u8(static_cast<uint8_t>(record.type));
+    out.i32(record.player);
+    out.i32(record.kind);
+    out.i32(record.value);
+    out.str(record.first);
+    out.str(record.second);
+    out.patchU32(start, static_cast<uint32_t>(out.size() - start - 4));
+
+    switch (options.sync) {
+        case JournalOptions::Sync::None:
+            if (buffer.size() >= BLOCK_SIZE) flush();
+            break;
+        case JournalOptions::Sync::Flush:
+            flush();
+            break;
+        case JournalOptions::Sync::Periodic:
+            flush();
+            if (++unsynced >= options.syncEvery) {
+                syncFile(fd);
+                unsynced = 0;
+            }
+            break;
+        case JournalOptions::Sync::Always:
+            flush();
+            syncFile(fd);
+            break;
+    }
+}
+
+void JournalWriter::sync() {
+    flush();
+    syncFile(fd);
+    unsynced = 0;
+}
+
+void JournalWriter::flush() {
+    size_t written = 0;
+    while (written < buffer.size()) {
+        const long n = writeFile(fd, buffer.data() + written, buffer.size() - written);
+        if (n <= 0) {
+            buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(written));
+            throw std::runtime_error("Could not write journal: " + path);
+        }
+        written += static_cast<size_t>(n);
+    }
+    buffer.clear();
+}
+
+std::vector<JournalRecord> JournalReader::readAll(const std::string& path) {
+    std::vector<JournalRecord> records;
+    parse(readFileData(path), path, &records);
+    return records;
+}
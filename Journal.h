@@ -0,0 +1,120 @@
+//
+// Journal.h
+// Append-only binary log of a game's commands and orders, for crash recovery and replays.
+//
+
+#ifndef COMP345_RISK_JOURNAL_H
+#define COMP345_RISK_JOURNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Order;
+
+enum class JournalRecordType : uint8_t {
+    Command = 1,  // kind = CommandTypes, first = parameter
+    Seed,         // value = seed the game was set up with
+    Reinforce,    // the reinforcement phase ran
+    IssuedOrder,  // player issued an order: kind = JournalOrderKind, value = armies, first/second = territories or player
+    CardPlayed,   // player played a card: kind = CardType
+    Conquest,     // player took territory value while deciding (strategies that change the board directly)
+    Pool,         // player's reinforcement pool is value after issuing orders
+    Execute       // the execute-orders phase ran; kind/value = high/low half of GameState::getHash() before executing
+};
+
+enum class JournalOrderKind : uint8_t { Deploy, Advance, Bomb, Blockade, Airlift, Negotiate };
+
+/**
+ * One journal entry. Which fields mean something depends on the type; see JournalRecordType.
+ */
+struct JournalRecord {
+    JournalRecordType type = JournalRecordType::Command;
+    int32_t player = -1;
+    int32_t kind = 0;
+    int32_t value = 0;
+    std::string first;
+    std::string second;
+
+    static JournalRecord fromOrder(int player, const Order& order);
+
+    /**
+     * New order for an IssuedOrder record, or nullptr if the record holds none.
+     */
+    Order* toOrder() const;
+};
+
+/**
+ * How often written records are forced to disk, and what happens to records already in the file.
+ */
+struct JournalOptions {
+    enum class Sync {
+        None,      // records are buffered and written in blocks; lost if the process dies
+        Flush,     // every record is handed to the OS at once; survives the process dying
+        Periodic,  // as Flush, plus fsync every syncEvery records; survives power loss up to the last sync
+        Always     // fsync after every record
+    };
+    Sync sync = Sync::Flush;
+    size_t syncEvery = 64;
+    // Append after the records already in the file, to carry on a game after a crash. Otherwise
+    // an existing journal is started over, so records of two games never end up in one file.
+    bool resume = false;
+};
+
+/**
+ * Appends records to a journal file:
+ *
+ *     header:  "RJNL" u16 version
+ *     record:  u32 length, then length bytes: u8 type, i32 player, i32 kind, i32 value,
+ *              u32 size + bytes of first, u32 size + bytes of second
+ *
+ * All integers are little-endian. Opening an existing journal empties it, unless resuming:
+ * then new records are appended, after cutting off a last record left incomplete by a crash.
+ */
+class JournalWriter {
+public:
+    static constexpr uint16_t VERSION = 2;
+
+    /**
+     * @throws std::runtime_error if the file can't be opened or isn't a journal
+     */
+    explicit JournalWriter(const std::string& path, JournalOptions options = {});
+    JournalWriter(const JournalWriter& other) = delete;
+    JournalWriter& operator=(const JournalWriter& other) = delete;
+    ~JournalWriter();
+
+    void append(const JournalRecord& record);
+
+    /**
+     * Writes buffered records and forces them to disk, whatever the sync policy.
+     */
+    void sync();
+
+    const std::string& getPath() const { return path; }
+
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    std::string path;
+    JournalOptions options;
+    int fd;
+    std::vector<char> buffer;
+    size_t unsynced;
+
+    void flush();
+};
+
+/**
+ * Reads a whole journal into memory with a single read. A record cut short at the end of the file,
+ * as left by a crash mid-write, is dropped; everything before it is returned.
+ */
+class JournalReader {
+public:
+    /**
+     * @throws std::runtime_error if the file can't be read or isn't a journal
+     */
+    static std::vector<JournalRecord> readAll(const std::string& path);
+};
+
+#endif // COMP345_RISK_JOURNAL_H
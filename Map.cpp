@@ -8,6 +8,7 @@
 #include <vector>
 #include <iostream>
 #include <algorithm>
+#include <functional>
 using namespace std;
 
 //default constructor for Map
@@ -36,6 +37,7 @@ Map::Map(string name, unordered_map<string, int> continents, const vector<territ
         }
 
         node.continent = terr.continent;
+        territoryIndex[node.name] = static_cast<int>(territoryNodes.size());
         territoryNodes.push_back(node);
     }
 
@@ -85,6 +87,7 @@ Map::Map(const Map& other) {
     name = other.name;
     continents = other.continents;
     territoryNodes = other.territoryNodes;
+    territoryIndex = other.territoryIndex;
 }
 
 //assignment operator for Map
@@ -93,6 +96,8 @@ Map& Map::operator=(const Map& other) {
         name = other.name;
         continents = other.continents;
         territoryNodes = other.territoryNodes;
+        territoryIndex = other.territoryIndex;
+        topology.reset();  // built again for the new territories on first use
     }
     return *this;
 }
@@ -221,6 +226,23 @@ const vector<Map::territoryNode>& Map::getTerritoryNodes() const {
     return territoryNodes;
 }
 
+int Map::indexOf(const string& territoryName) const {
+    auto it = territoryIndex.find(territoryName);
+    return it == territoryIndex.end() ? -1 : it->second;
+}
+
+int Map::indexOf(const territoryNode* node) const {
+    if (!node || territoryNodes.empty()) return -1;
+    std::less<const territoryNode*> before;
+    if (before(node, territoryNodes.data()) || !before(node, territoryNodes.data() + territoryNodes.size())) return -1;
+    return static_cast<int>(node - territoryNodes.data());
+}
+
+Map::territoryNode* Map::findTerritory(const string& territoryName) {
+    int index = indexOf(territoryName);
+    return index < 0 ? nullptr : &territoryNodes[index];
+}
+
 string Map::toString() {
     string result = "Map Name: " + name + "\nContinents:\n";
     for (auto const& [key, val] : continents) {
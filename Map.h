@@ -5,11 +5,15 @@
 #ifndef COMP345_RISK_MAP_H
 #define COMP345_RISK_MAP_H
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 using namespace std;
 
+class Player;
+class MapTopology;
+
 class Map {
     // Constructor: Read a .map file and initialize the Map object.
     public:
@@ -25,6 +29,8 @@ class Map {
             string name;
             string continent;
             vector<int> adjacentIndices;
+            int armies = 0;
+            Player* owner = nullptr;
         };
 
         Map();
@@ -41,12 +47,22 @@ class Map {
         string getName() const { return name; }
         vector<territoryNode>& getTerritoryNodes();
         const vector<territoryNode>& getTerritoryNodes() const;
+
+        // Lookups by name and by node address. Return -1 / nullptr when the territory is not on this map.
+        int indexOf(const string& territoryName) const;
+        int indexOf(const territoryNode* node) const;
+        territoryNode* findTerritory(const string& territoryName);
     private:
         string name;
         // Unordered map (effectively a dictionary) of continents and their control values.
         unordered_map<string, int> continents;
         // List of territories.
         vector<territoryNode> territoryNodes;
+        // Built by MapTopology::of() on first use; territories and borders never change after loading.
+        mutable shared_ptr<const MapTopology> topology;
+        friend class MapTopology;
+        // Territory name to index in territoryNodes.
+        unordered_map<string, int> territoryIndex;
         int armyCount;
         // TODO: Switch this with a Player reference.
         int ownerID;
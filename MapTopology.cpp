@@ -0,0 +1,38 @@
+//
+// MapTopology.cpp
+// Immutable per-map data shared by every game and strategy on that map.
+//
+
+#include "MapTopology.h"
+#include <mutex>
+#include <unordered_map>
+
+MapTopology::MapTopology(const Map& map) {
+    const auto& nodes = map.getTerritoryNodes();
+    rowStart.reserve(nodes.size() + 1);
+    rowStart.push_back(0);
+    continentIndex.reserve(nodes.size());
+
+    std::unordered_map<std::string, int> continentIds;
+    for (size_t t = 0; t < nodes.size(); ++t) {
+        columns.insert(columns.end(), nodes[t].adjacentIndices.begin(), nodes[t].adjacentIndices.end());
+        rowStart.push_back(static_cast<int>(columns.size()));
+
+        auto inserted = continentIds.emplace(nodes[t].continent, static_cast<int>(continents.size()));
+        if (inserted.second) continents.emplace_back();
+        continentIndex.push_back(inserted.first->second);
+        continents[inserted.first->second].push_back(static_cast<int>(t));
+    }
+}
+
+std::shared_ptr<const MapTopology> MapTopology::of(const Map* map) {
+    if (!map) return nullptr;
+
+    // Games on the same map may start on several threads at once.
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!map->topology) {
+        map->topology = std::make_shared<const MapTopology>(*map);
+    }
+    return map->topology;
+}
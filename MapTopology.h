@@ -0,0 +1,51 @@
+//
+// MapTopology.h
+// Immutable per-map data shared by every game and strategy on that map.
+//
+
+#ifndef COMP345_RISK_MAPTOPOLOGY_H
+#define COMP345_RISK_MAPTOPOLOGY_H
+
+#include "Map.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * What never changes about a map once it is loaded: the adjacency in CSR form and the
+ * territories of each continent. Built once and shared read-only, so any number of games,
+ * strategies and threads can use it without copying or locking.
+ */
+class MapTopology {
+public:
+    explicit MapTopology(const Map& map);
+    MapTopology(const MapTopology& other) = delete;
+    MapTopology& operator=(const MapTopology& other) = delete;
+
+    /**
+     * Topology of the given map, built on first use and kept by the Map itself, so every game on
+     * that Map shares it and it can never outlive the map or be handed to a different one.
+     * Copies of a Map build their own on first use.
+     */
+    static std::shared_ptr<const MapTopology> of(const Map* map);
+
+    size_t territoryCount() const { return rowStart.size() - 1; }
+    size_t edgeCount() const { return columns.size(); }
+
+    // CSR rows: the neighbours of territory t are columns[rowStart[t]] .. columns[rowStart[t + 1] - 1].
+    const std::vector<int>& getRowStart() const { return rowStart; }
+    const std::vector<int>& getColumns() const { return columns; }
+    int degree(int territory) const { return rowStart[territory + 1] - rowStart[territory]; }
+
+    // Continent index of each territory, and the territory ids of each continent.
+    int continentOf(int territory) const { return continentIndex[territory]; }
+    const std::vector<std::vector<int>>& getContinents() const { return continents; }
+
+private:
+    std::vector<int> rowStart;
+    std::vector<int> columns;
+    std::vector<int> continentIndex;
+    std::vector<std::vector<int>> continents;
+};
+
+#endif // COMP345_RISK_MAPTOPOLOGY_H
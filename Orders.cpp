@@ -1,6 +1,9 @@
 
 
 #include "Orders.h"
+#include "GameState.h"
+#include "Player.h"
+#include <algorithm>
 #include <sstream>
 
 
@@ -8,12 +11,14 @@
 Order::Order() {
     executed = new bool(false);
     effect = new std::string("");
+    issuer = nullptr;
 }
 
 //copy constructor for Order
 Order::Order(const Order& other) {
     executed = new bool(*(other.executed));
     effect = new std::string(*(other.effect));
+    issuer = other.issuer;
 }
 
 //destructor for Order
@@ -30,6 +35,7 @@ Order& Order::operator=(const Order& other) {
 
         executed = new bool(*(other.executed));
         effect = new std::string(*(other.effect));
+        issuer = other.issuer;
     }
     return *this;
 }
@@ -44,6 +50,27 @@ std::string Order::getEffect() const {
     return *effect;
 }
 
+//mark the order as not executed so it can run again
+void Order::resetExecution() {
+    *executed = false;
+    effect->clear();
+}
+
+//get the player who issued the order
+Player* Order::getIssuer() const {
+    return issuer;
+}
+
+//set the player who issued the order
+void Order::setIssuer(Player* p) {
+    issuer = p;
+}
+
+//execute against a running game, orders without board effects only record their effect
+void Order::execute(GameState& /*state*/) {
+    execute();
+}
+
 //stream insertion operator for Order
 std::ostream& operator<<(std::ostream& os, const Order& order) {
     os << order.getDescription();
@@ -116,6 +143,24 @@ void Deploy::execute() {
     }
 }
 
+//execute Deploy order against the game: armies land on a territory the issuer owns
+void Deploy::execute(GameState& state) {
+    Map::territoryNode* target = state.findTerritory(*targetTerritory);
+    if (!validate() || !target || !issuer || target->owner != issuer) {
+        *effect = "Deploy order is invalid and was not executed";
+        *executed = true;
+        return;
+    }
+
+    state.setArmies(target, target->armies + *armyUnits);
+
+    std::ostringstream oss;
+    oss << "Deployed " << *armyUnits << " army units to " << *targetTerritory
+        << " (now " << target->armies << ")";
+    *effect = oss.str();
+    *executed = true;
+}
+
 //clone Deploy order for deep copying
 Order* Deploy::clone() const {
     return new Deploy(*this);
@@ -209,6 +254,76 @@ void Advance::execute() {
     }
 }
 
+//the battle this order would fight if it executed now, false for moves and invalid orders
+bool Advance::pendingBattle(const GameState& state, BattleRequest& battle) const {
+    const Map::territoryNode* source = state.findTerritory(*sourceTerritory);
+    const Map::territoryNode* target = state.findTerritory(*targetTerritory);
+    if (*armyUnits <= 0 || !source || !target || source == target || !issuer || source->owner != issuer ||
+        target->owner == issuer || !state.areAdjacent(source, target)) {
+        return false;
+    }
+    battle.attackers = std::min(*armyUnits, source->armies);
+    battle.defenders = target->armies;
+    return true;
+}
+
+//execute Advance order against the game: move between own territories or attack an enemy one
+void Advance::execute(GameState& state) {
+    BattleRequest battle{};
+    if (pendingBattle(state, battle)) {
+        execute(state, state.getCombat().resolve(battle.attackers, battle.defenders));
+        return;
+    }
+
+    Map::territoryNode* source = state.findTerritory(*sourceTerritory);
+    Map::territoryNode* target = state.findTerritory(*targetTerritory);
+    if (!validate() || !source || !target || !issuer || source->owner != issuer || !state.areAdjacent(source, target)) {
+        *effect = "Advance order is invalid and was not executed";
+        *executed = true;
+        return;
+    }
+
+    const int moving = std::min(*armyUnits, source->armies);
+    state.setArmies(source, source->armies - moving);
+    state.setArmies(target, target->armies + moving);
+
+    std::ostringstream oss;
+    oss << "Moved " << moving << " army units from " << *sourceTerritory << " to " << *targetTerritory;
+    *effect = oss.str();
+    *executed = true;
+}
+
+//execute an attacking Advance whose battle was already resolved, e.g. in a batch with the turn's other battles
+void Advance::execute(GameState& state, const BattleOutcome& outcome) {
+    Map::territoryNode* source = state.findTerritory(*sourceTerritory);
+    Map::territoryNode* target = state.findTerritory(*targetTerritory);
+    Player* defender = target->owner;
+    state.publish(GameEvent{GameEventType::TerritoryAttacked, issuer, defender, target});
+
+    const int moving = std::min(*armyUnits, source->armies);
+    const int defenders = target->armies;
+    const int survivors = moving - outcome.attackerLosses;
+    std::ostringstream oss;
+
+    state.setArmies(source, source->armies - moving);
+    if (outcome.defenderLosses >= defenders && survivors > 0) {
+        state.setOwner(target, issuer);
+        state.setArmies(target, survivors);
+        state.publish(GameEvent{GameEventType::TerritoryConquered, issuer, defender, target});
+        state.awardConquestCard(issuer);
+        oss << "Conquered " << *targetTerritory << " from " << *sourceTerritory << " with "
+            << survivors << " of " << moving << " army units surviving";
+    } else {
+        state.setArmies(target, defenders - outcome.defenderLosses);
+        state.setArmies(source, source->armies + survivors);
+        oss << "Attacked " << *targetTerritory << " from " << *sourceTerritory << ": lost "
+            << outcome.attackerLosses << ", killed " << outcome.defenderLosses;
+    }
+
+    *effect = oss.str();
+    *executed = true;
+}
+
 //clone Advance order
 Order* Advance::clone() const {
     return new Advance(*this);
@@ -281,6 +396,25 @@ void Bomb::execute() {
     }
 }
 
+//execute Bomb order against the game: halves an enemy territory next to one of the issuer's
+void Bomb::execute(GameState& state) {
+    Map::territoryNode* target = state.findTerritory(*targetTerritory);
+    if (!validate() || !target || !issuer || target->owner == issuer || !state.bordersPlayer(target, issuer)) {
+        *effect = "Bomb order is invalid and was not executed";
+        *executed = true;
+        return;
+    }
+
+    state.publish(GameEvent{GameEventType::TerritoryAttacked, issuer, target->owner, target});
+    const int destroyed = target->armies / 2;
+    state.setArmies(target, target->armies - destroyed);
+
+    std::ostringstream oss;
+    oss << "Bombed territory " << *targetTerritory << ", destroying " << destroyed << " army units";
+    *effect = oss.str();
+    *executed = true;
+}
+
 //clone Bomb order
 Order* Bomb::clone() const {
     return new Bomb(*this);
@@ -350,6 +484,26 @@ void Blockade::execute() {
     }
 }
 
+//execute Blockade order against the game: triple the armies on an own territory and hand it to the Neutral player
+void Blockade::execute(GameState& state) {
+    Map::territoryNode* target = state.findTerritory(*targetTerritory);
+    if (!validate() || !target || !issuer || target->owner != issuer) {
+        *effect = "Blockade order is invalid and was not executed";
+        *executed = true;
+        return;
+    }
+
+    Player* neutral = state.getNeutralPlayer();
+    state.setArmies(target, target->armies * 3);
+    state.setOwner(target, neutral);
+
+    std::ostringstream oss;
+    oss << "Blockaded territory " << *targetTerritory << ", tripled army units to " << target->armies
+        << " and handed it to " << neutral->getName();
+    *effect = oss.str();
+    *executed = true;
+}
+
 //clone Blockade order
 Order* Blockade::clone() const {
     return new Blockade(*this);
@@ -436,6 +590,26 @@ void Airlift::execute() {
     }
 }
 
+//execute Airlift order against the game: move armies between any two own territories
+void Airlift::execute(GameState& state) {
+    Map::territoryNode* source = state.findTerritory(*sourceTerritory);
+    Map::territoryNode* target = state.findTerritory(*targetTerritory);
+    if (!validate() || !source || !target || !issuer || source->owner != issuer || target->owner != issuer) {
+        *effect = "Airlift order is invalid and was not executed";
+        *executed = true;
+        return;
+    }
+
+    const int moving = std::min(*armyUnits, source->armies);
+    state.setArmies(source, source->armies - moving);
+    state.setArmies(target, target->armies + moving);
+
+    std::ostringstream oss;
+    oss << "Airlifted " << moving << " army units from " << *sourceTerritory << " to " << *targetTerritory;
+    *effect = oss.str();
+    *executed = true;
+}
+
 //clone Airlift order
 Order* Airlift::clone() const {
     return new Airlift(*this);
@@ -631,6 +805,51 @@ void OrdersList::executeAll() {
     }
 }
 
+//execute all orders in the list against a running game, journaled if the state records undo.
+//Consecutive attacks that share no territory can't change each other's armies, so their
+//battles are resolved together in the combat kernel's lanes before they are applied in order.
+void OrdersList::executeAll(GameState& state) {
+    std::vector<Advance*> attacks;
+    std::vector<BattleRequest> battles;
+    std::vector<BattleOutcome> outcomes;
+    std::vector<const Map::territoryNode*> touched;
+
+    size_t next = 0;
+    while (next < orders->size()) {
+        attacks.clear();
+        battles.clear();
+        touched.clear();
+        for (size_t i = next; i < orders->size(); ++i) {
+            Advance* advance = dynamic_cast<Advance*>((*orders)[i]);
+            BattleRequest battle{};
+            if (!advance || advance->isExecuted() || !advance->pendingBattle(state, battle)) break;
+            const Map::territoryNode* source = state.findTerritory(advance->getSourceTerritory());
+            const Map::territoryNode* target = state.findTerritory(advance->getTargetTerritory());
+            if (std::find(touched.begin(), touched.end(), source) != touched.end() ||
+                std::find(touched.begin(), touched.end(), target) != touched.end()) {
+                break;
+            }
+            touched.push_back(source);
+            touched.push_back(target);
+            attacks.push_back(advance);
+            battles.push_back(battle);
+        }
+
+        if (attacks.size() < 2) {
+            Order* order = (*orders)[next++];
+            if (order && !order->isExecuted()) state.apply(order);
+            continue;
+        }
+
+        outcomes.resize(battles.size());
+        state.getCombat().resolveBatch(battles.data(), outcomes.data(), battles.size());
+        for (size_t i = 0; i < attacks.size(); ++i) {
+            state.apply(attacks[i], outcomes[i]);
+        }
+        next += attacks.size();
+    }
+}
+
 //stream insertion operator for OrdersList
 std::ostream& operator<<(std::ostream& os, const OrdersList& ordersList) {
     os << "OrdersList (" << ordersList.size() << " orders):\n";
@@ -7,11 +7,17 @@
 #include <vector>
 using namespace std;
 
+class Player;
+class GameState;
+struct BattleRequest;
+struct BattleOutcome;
+
 class Order {
 
     protected:
         bool* executed;
         string* effect;
+        Player* issuer;
 
     public:
         Order();
@@ -22,11 +28,17 @@ class Order {
 
         virtual bool validate() =0;
         virtual void execute() =0;
+        // Executes the order against a running game. Orders that don't touch the board yet fall back to execute().
+        virtual void execute(GameState& state);
         virtual Order* clone() const =0;
         virtual string getDescription() const = 0;
 
         bool isExecuted() const;
         string getEffect() const;
+        // Marks the order as not executed again, e.g. after GameState::rollback().
+        void resetExecution();
+        Player* getIssuer() const;
+        void setIssuer(Player* p);
 
         friend ostream& operator<<(ostream& os, const Order& order);
 };
@@ -46,6 +58,7 @@ class Deploy : public Order {
         Deploy& operator=(const Deploy& other);
         bool validate() override;
         void execute() override;
+        void execute(GameState& state) override;
         Order* clone() const override;
         string getDescription() const override;
 
@@ -70,6 +83,11 @@ class Advance : public Order {
 
         bool validate() override;
         void execute() override;
+        void execute(GameState& state) override;
+        // Attacks only: applies a battle outcome resolved ahead of time, e.g. by CombatKernel::resolveBatch().
+        void execute(GameState& state, const BattleOutcome& outcome);
+        // Fills in the battle this order would fight if it executed now. False for moves and invalid orders.
+        bool pendingBattle(const GameState& state, BattleRequest& battle) const;
         Order* clone() const override;
         string getDescription() const override;
 
@@ -94,6 +112,7 @@ class Bomb : public Order {
 
         bool validate() override;
         void execute() override;
+        void execute(GameState& state) override;
         Order* clone() const override;
         string getDescription() const override;
         string getTargetTerritory() const;
@@ -111,6 +130,7 @@ class Blockade : public Order {
         Blockade& operator=(const Blockade& other);
         bool validate() override;
         void execute() override;
+        void execute(GameState& state) override;
         Order* clone() const override;
         string getDescription() const override;
         string getTargetTerritory() const;
@@ -132,6 +152,7 @@ class Airlift: public Order {
 
         bool validate() override;
         void execute() override;
+        void execute(GameState& state) override;
         Order* clone() const override;
         string getDescription() const override;
         int getArmyUnits() const;
@@ -177,6 +198,7 @@ class OrdersList {
         int size() const;
         bool empty() const;
         void executeAll();
+        void executeAll(GameState& state);
         friend ostream& operator<<(ostream& os, const OrdersList& orders);
 };
 
@@ -16,7 +16,9 @@ Player::Player(const string& n)
           hand(new Hand()),
           ordersList(new OrdersList()),
           reinforcementPool(0),
-          strategy(nullptr) {
+          strategy(nullptr),
+          gameState(nullptr),
+          holdingOrders(false) {
     cout << "[Player] Created player '" << *name << "'\n";
 }
 
@@ -27,7 +29,9 @@ Player::Player(const Player& other)
           hand(new Hand(*other.hand)),
           ordersList(new OrdersList(*other.ordersList)),
           reinforcementPool(other.reinforcementPool),
-          strategy(other.strategy ? other.strategy->clone() : nullptr) {
+          strategy(other.strategy ? other.strategy->clone() : nullptr),
+          gameState(other.gameState),
+          holdingOrders(false) {
 
     //copy territories (shallow)
     for (auto* t : *other.ownedTerritories) {
@@ -57,6 +61,7 @@ Player& Player::operator=(const Player& other) {
         ordersList = new OrdersList(*other.ordersList);
         reinforcementPool = other.reinforcementPool;
         strategy = other.strategy ? other.strategy->clone() : nullptr;
+        gameState = other.gameState;
     }
     return *this;
 }
@@ -69,17 +74,35 @@ Player::~Player() {
     delete hand;
     delete ordersList;
     delete strategy;
+    for (Order* order : heldOrders) delete order;
 }
 
 //issueOrder(Order*) method: directly adds the given order to the player's OrdersList
 //This is used internally by strategies to actually add orders
 void Player::issueOrder(Order* order) {
     if (!order) return;
+    order->setIssuer(this);
+    if (holdingOrders) {
+        heldOrders.push_back(order);
+        return;
+    }
     ordersList->addOrder(order);
     cout << "[Player::issueOrder] " << *name
          << " issued: " << *order << endl;
 }
 
+void Player::holdOrders() {
+    holdingOrders = true;
+}
+
+void Player::releaseOrders() {
+    holdingOrders = false;
+    for (Order* order : heldOrders) {
+        issueOrder(order);
+    }
+    heldOrders.clear();
+}
+
 // Strategy management methods
 void Player::setStrategy(PlayerStrategy* s) {
     if (strategy != s) {
@@ -96,14 +119,32 @@ PlayerStrategy* Player::getStrategy() const {
     return strategy;
 }
 
+void Player::setGameState(GameState* state) {
+    gameState = state;
+}
+
+GameState* Player::getGameState() const {
+    return gameState;
+}
+
 //addTerritory() method: adds a territory to a players owned territories
 void Player::addTerritory(Map::territoryNode* t) {
-    if (t) ownedTerritories->push_back(t);
+    if (!t) return;
+    ownedTerritories->push_back(t);
+    t->owner = this;
+}
+
+//removeTerritory() method: removes a territory from a players owned territories
+void Player::removeTerritory(Map::territoryNode* t) {
+    if (!t) return;
+    auto it = find(ownedTerritories->begin(), ownedTerritories->end(), t);
+    if (it != ownedTerritories->end()) ownedTerritories->erase(it);
+    if (t->owner == this) t->owner = nullptr;
 }
 
 //addCard() method: adds a card to a player's hand
-void Player::addCard(Card* c) {
-    if (c) hand->addCard(c);
+bool Player::addCard(CardType type) {
+    return hand->addCard(type);
 }
 
 //toDefend() method: delegates to strategy
@@ -135,6 +176,15 @@ void Player::issueOrder() {
     }
 }
 
+//issueOrder(context) method: delegates to strategy's issueOrder(context)
+void Player::issueOrder(const DecisionContext& context) {
+    if (strategy) {
+        strategy->issueOrder(context);
+    } else {
+        cout << "[Player::issueOrder] " << *name << " has no strategy, cannot issue orders.\n";
+    }
+}
+
 // Getters
 string Player::getName() const { return *name; }
 const vector<Map::territoryNode*>* Player::getOwnedTerritories() const { return ownedTerritories; }
@@ -153,6 +203,9 @@ void Player::addReinforcements(int armies) {
 }
 
 void Player::clearTerritories() {
+    for (auto* t : *ownedTerritories) {
+        if (t->owner == this) t->owner = nullptr;
+    }
     ownedTerritories->clear();
 }
 
@@ -6,6 +6,7 @@
 #define COMP345_RISK_PLAYER_H
 
 #include "Map.h"    // required for Map::territoryNode
+#include <cstdint>
 #include <iostream>
 #include <vector>
 #include <string>
@@ -15,7 +16,10 @@ class Order;
 class OrdersList;
 class Hand;
 class Card;
+enum class CardType : uint8_t;
 class PlayerStrategy;
+class GameState;
+struct DecisionContext;
 
 using namespace std;
 
@@ -27,6 +31,9 @@ private:
     OrdersList* ordersList;
     int reinforcementPool;
     PlayerStrategy* strategy;  // Strategy pattern: player behavior
+    GameState* gameState;      // Game the player is in, set by the engine at gamestart (not owned)
+    vector<Order*> heldOrders; // Orders issued between holdOrders() and releaseOrders()
+    bool holdingOrders;
 
 public:
     Player(const string& n = "Player");
@@ -36,18 +43,29 @@ public:
 
     // Strategy pattern delegation methods
     void issueOrder();  // Delegates to strategy's issueOrder()
+    void issueOrder(const DecisionContext& context);  // Same, within the context's deadline
     vector<Map::territoryNode*> toDefend() const;  // Delegates to strategy
     vector<Map::territoryNode*> toAttack() const;  // Delegates to strategy
     
     // Direct order issuing (used internally by strategies)
     void issueOrder(Order* order);
+
+    // While held, issued orders are kept aside instead of going to the OrdersList, so a strategy
+    // can run on another thread; releaseOrders() appends them in issue order.
+    void holdOrders();
+    void releaseOrders();
     
     // Strategy management
     void setStrategy(PlayerStrategy* s);
     PlayerStrategy* getStrategy() const;
 
+    void setGameState(GameState* state);
+    GameState* getGameState() const;
+
     void addTerritory(Map::territoryNode* t);
-    void addCard(Card* c);
+    void removeTerritory(Map::territoryNode* t);
+    // False if the hand is full of that kind; the caller keeps the card.
+    bool addCard(CardType type);
 
     string getName() const;
     const vector<Map::territoryNode*>* getOwnedTerritories() const;
@@ -23,10 +23,8 @@ void testPlayers() {
     alice.addTerritory(&ontario);
 
     // Add some cards
-    Card* bomb = new Card("bomb");
-    Card* airlift = new Card("airlift");
-    alice.addCard(bomb);
-    alice.addCard(airlift);
+    alice.addCard(CardType::Bomb);
+    alice.addCard(CardType::Airlift);
 
     // Create and issue some orders
     Deploy* deploy = new Deploy(5, "Quebec");
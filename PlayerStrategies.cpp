@@ -8,11 +8,25 @@
 #include "Orders.h"
 #include "Cards.h"
 #include "Map.h"
+#include "GameState.h"
+#include "InfluenceMap.h"
+#include "ThreadPool.h"
+#include "TranspositionTable.h"
+#include "Zobrist.h"
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <random>
 #include <sstream>
 #include <limits>
 
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
 // Forward declaration to avoid circular dependency
 class GameEngine;
 
@@ -38,6 +52,74 @@ PlayerStrategy& PlayerStrategy::operator=(const PlayerStrategy& other) {
 PlayerStrategy::~PlayerStrategy() {
 }
 
+void PlayerStrategy::issueOrder(const DecisionContext&) {
+    issueOrder();
+}
+
+bool PlayerStrategy::chooseCardTarget(CardType type, CardTarget& target) const {
+    GameState* state = player ? player->getGameState() : nullptr;
+    if (!state || !state->getMap()) return false;
+    const auto& nodes = state->getMap()->getTerritoryNodes();
+    const MapTopology& topology = state->getTopology();
+    const int* start = topology.getRowStart().data();
+    const int* cols = topology.getColumns().data();
+    const std::vector<float>& threat = state->getThreat(player);
+
+    int weakest = -1;      // own territory with most pressure beyond its armies
+    int reserve = -1;      // own territory with no enemy neighbour and most armies
+    int strongest = -1;    // enemy neighbour with most armies
+    float weakestGap = 0.0f;
+    std::vector<int> border(state->getPlayers().size(), 0);
+    for (const Map::territoryNode* owned : *player->getOwnedTerritories()) {
+        const int id = state->territoryId(owned);
+        if (id < 0) continue;
+        const float gap = threat[id] - owned->armies;
+        if (weakest < 0 || gap > weakestGap) {
+            weakest = id;
+            weakestGap = gap;
+        }
+        bool frontier = false;
+        for (int k = start[id]; k < start[id + 1]; ++k) {
+            const Map::territoryNode& neighbour = nodes[cols[k]];
+            if (!neighbour.owner || neighbour.owner == player) continue;
+            frontier = true;
+            if (strongest < 0 || neighbour.armies > nodes[strongest].armies) strongest = cols[k];
+            const int owner = state->playerId(neighbour.owner);
+            if (owner >= 0) border[owner] += neighbour.armies;
+        }
+        if (!frontier && owned->armies > 1 && (reserve < 0 || owned->armies > nodes[reserve].armies)) {
+            reserve = id;
+        }
+    }
+
+    switch (type) {
+        case CardType::Bomb:
+            target.territory = strongest;
+            return strongest >= 0;
+        case CardType::Reinforcement:
+            target.territory = weakest;
+            return weakest >= 0;
+        case CardType::Blockade:
+            // Only worth giving a territory away when it would fall anyway.
+            if (weakest < 0 || threat[weakest] <= 3.0f * nodes[weakest].armies) return false;
+            target.territory = weakest;
+            return true;
+        case CardType::Airlift:
+            if (weakest < 0 || reserve < 0 || reserve == weakest || weakestGap <= 0.0f) return false;
+            target.source = reserve;
+            target.territory = weakest;
+            target.armies = nodes[reserve].armies - 1;
+            return true;
+        case CardType::Diplomacy: {
+            const auto most = std::max_element(border.begin(), border.end());
+            if (most == border.end() || *most == 0) return false;
+            target.player = static_cast<int>(most - border.begin());
+            return true;
+        }
+    }
+    return false;
+}
+
 void PlayerStrategy::setPlayer(Player* p) {
     player = p;
 }
@@ -257,17 +339,6 @@ void HumanPlayerStrategy::playCards() {
     }
 
     std::cout << "\n--- Card Playing Phase ---\n";
-    const auto* cards = hand->getCards();
-    if (!cards || cards->empty()) {
-        return;
-    }
-
-    std::cout << "Your cards: ";
-    for (size_t i = 0; i < cards->size(); ++i) {
-        std::cout << (i + 1) << ". " << cards->at(i)->getType();
-        if (i + 1 < cards->size()) std::cout << ", ";
-    }
-    std::cout << "\n";
 
     std::string playMore = "yes";
     while (playMore == "yes" || playMore == "y") {
@@ -276,68 +347,69 @@ void HumanPlayerStrategy::playCards() {
             break;
         }
 
-        int cardIndex = getIntInput("Enter card number to play (or 0 to skip): ", 0, static_cast<int>(hand->size()));
+        // One menu entry per kind held.
+        CardType held[CARD_TYPE_COUNT];
+        int kinds = 0;
+        std::cout << "Your cards: ";
+        for (int i = 0; i < CARD_TYPE_COUNT; ++i) {
+            const CardType type = static_cast<CardType>(i);
+            if (hand->count(type) == 0) continue;
+            if (kinds > 0) std::cout << ", ";
+            held[kinds++] = type;
+            std::cout << kinds << ". " << CardsUtil::name(type) << " x" << hand->count(type);
+        }
+        std::cout << "\n";
+
+        int cardIndex = getIntInput("Enter card number to play (or 0 to skip): ", 0, kinds);
         if (cardIndex == 0) {
             break;
         }
 
-        if (cardIndex < 1 || cardIndex > static_cast<int>(hand->size())) {
+        if (cardIndex < 1 || cardIndex > kinds) {
             std::cout << "Invalid card number.\n";
             continue;
         }
 
-        Card* cardToPlay = cards->at(cardIndex - 1);
-        std::string cardType = cardToPlay->getType();
+        const CardType cardType = held[cardIndex - 1];
 
         // For human players, we need to get specific parameters for card orders
-        if (cardType == "bomb") {
-            std::string targetTerritory;
-            std::cout << "Enter target territory for bomb: ";
-            std::getline(std::cin, targetTerritory);
-            if (!targetTerritory.empty()) {
-                player->issueOrder(new Bomb(targetTerritory));
-                hand->removeCard(cardToPlay);
-                // Note: In a full implementation, we'd return the card to the deck
-            }
-        } else if (cardType == "reinforcement") {
-            std::string targetTerritory;
-            int armies;
-            std::cout << "Enter target territory for reinforcement: ";
-            std::getline(std::cin, targetTerritory);
-            armies = getIntInput("Enter number of armies: ", 1, 1000);
-            if (!targetTerritory.empty() && armies > 0) {
-                player->issueOrder(new Deploy(armies, targetTerritory));
-                hand->removeCard(cardToPlay);
-            }
-        } else if (cardType == "blockade") {
-            std::string targetTerritory;
-            std::cout << "Enter target territory for blockade: ";
-            std::getline(std::cin, targetTerritory);
-            if (!targetTerritory.empty()) {
-                player->issueOrder(new Blockade(targetTerritory));
-                hand->removeCard(cardToPlay);
-            }
-        } else if (cardType == "airlift") {
-            std::string source, target;
-            int armies;
-            std::cout << "Enter source territory: ";
-            std::getline(std::cin, source);
-            std::cout << "Enter target territory: ";
-            std::getline(std::cin, target);
-            armies = getIntInput("Enter number of armies: ", 1, 1000);
-            if (!source.empty() && !target.empty() && armies > 0) {
-                player->issueOrder(new Airlift(armies, source, target));
-                hand->removeCard(cardToPlay);
-            }
-        } else if (cardType == "diplomacy") {
-            std::string targetPlayer;
-            std::cout << "Enter target player name for diplomacy: ";
-            std::getline(std::cin, targetPlayer);
-            if (!targetPlayer.empty()) {
-                player->issueOrder(new Negotiate(targetPlayer));
-                hand->removeCard(cardToPlay);
+        GameState* state = player->getGameState();
+        if (!state || !state->getMap()) {
+            std::cout << "Cards can only be played in a running game.\n";
+            break;
+        }
+        auto territoryId = [state](const std::string& prompt) {
+            std::string name;
+            std::cout << prompt;
+            std::getline(std::cin, name);
+            return state->getMap()->indexOf(name);
+        };
+
+        CardTarget target;
+        switch (cardType) {
+            case CardType::Bomb:
+                target.territory = territoryId("Enter target territory for bomb: ");
+                break;
+            case CardType::Reinforcement:
+                target.territory = territoryId("Enter target territory for reinforcement: ");
+                break;
+            case CardType::Blockade:
+                target.territory = territoryId("Enter target territory for blockade: ");
+                break;
+            case CardType::Airlift:
+                target.source = territoryId("Enter source territory: ");
+                target.territory = territoryId("Enter target territory: ");
+                target.armies = getIntInput("Enter number of armies: ", 1, 1000);
+                break;
+            case CardType::Diplomacy: {
+                std::string targetPlayer;
+                std::cout << "Enter target player name for diplomacy: ";
+                std::getline(std::cin, targetPlayer);
+                target.player = state->playerId(state->findPlayer(targetPlayer));
+                break;
             }
         }
+        Card(cardType).play(player, state->getDeck(), hand, target);
 
         std::cout << "Play another card? (yes/no): ";
         std::getline(std::cin, playMore);
@@ -379,7 +451,7 @@ int HumanPlayerStrategy::getIntInput(const std::string& prompt, int min, int max
 }
 
 // ============================================================================
-// AggressivePlayerStrategy Implementation (Stub)
+// AggressivePlayerStrategy Implementation
 // ============================================================================
 
 AggressivePlayerStrategy::AggressivePlayerStrategy(Player* p) : PlayerStrategy(p) {}
@@ -400,26 +472,146 @@ PlayerStrategy* AggressivePlayerStrategy::clone() const {
     return new AggressivePlayerStrategy(*this);
 }
 
+AggressivePlayerStrategy::FrontLines AggressivePlayerStrategy::analyze() const {
+    FrontLines lines;
+    if (!player || !player->getGameState()) return lines;
+    const auto& nodes = player->getGameState()->getMap()->getTerritoryNodes();
+    const int count = static_cast<int>(nodes.size());
+
+    lines.distance.assign(count, -1);
+    lines.next.assign(count, -1);
+
+    // Seed with every enemy territory at distance 0 and only expand into our own territories,
+    // so each owned territory learns its distance and direction to the nearest front in O(T+E).
+    std::vector<int> queue;
+    queue.reserve(count);
+    for (int t = 0; t < count; ++t) {
+        if (nodes[t].owner != player) {
+            lines.distance[t] = 0;
+            queue.push_back(t);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const int current = queue[head];
+        for (int adj : nodes[current].adjacentIndices) {
+            if (nodes[adj].owner == player && lines.distance[adj] < 0) {
+                lines.distance[adj] = lines.distance[current] + 1;
+                lines.next[adj] = current;
+                queue.push_back(adj);
+            }
+        }
+    }
+    for (int t = 0; t < count; ++t) {
+        if (nodes[t].owner == player && lines.distance[t] == 0) lines.distance[t] = -1;
+    }
+
+    // Strongest territory on the front; the strongest overall only if no enemy can be reached.
+    for (auto* t : *player->getOwnedTerritories()) {
+        const int id = static_cast<int>(t - nodes.data());
+        if (lines.strongest < 0) {
+            lines.strongest = id;
+            continue;
+        }
+        const bool front = lines.distance[id] == 1;
+        const bool bestOnFront = lines.distance[lines.strongest] == 1;
+        if ((front && !bestOnFront) || (front == bestOnFront && t->armies > nodes[lines.strongest].armies)) {
+            lines.strongest = id;
+        }
+    }
+    return lines;
+}
+
+// A target's defenders plus a share of the enemy armies around it that could reinforce it.
+float AggressivePlayerStrategy::targetCost(const Map::territoryNode& target, float threat) {
+    return static_cast<float>(target.armies) + InfluenceMap::HOP_DECAY * threat;
+}
+
 std::vector<Map::territoryNode*> AggressivePlayerStrategy::toAttack() const {
-    // TODO: Implement aggressive attack logic
-    return {};
+    if (!player || !player->getGameState()) return {};
+    auto& nodes = player->getGameState()->getMap()->getTerritoryNodes();
+    const FrontLines lines = analyze();
+    const std::vector<float>& threat = player->getGameState()->getThreat(player);
+    auto cost = [&](const Map::territoryNode* t) { return targetCost(*t, threat[t - nodes.data()]); };
+
+    // Enemies next to the strongest territory come first, cheapest first; then the rest of the front.
+    std::vector<Map::territoryNode*> targets;
+    std::vector<bool> listed(nodes.size(), false);
+    auto addNeighbours = [&](int territory) {
+        const size_t first = targets.size();
+        for (int adj : nodes[territory].adjacentIndices) {
+            if (nodes[adj].owner != player && !listed[adj]) {
+                listed[adj] = true;
+                targets.push_back(&nodes[adj]);
+            }
+        }
+        std::sort(targets.begin() + first, targets.end(),
+                  [&](const Map::territoryNode* a, const Map::territoryNode* b) { return cost(a) < cost(b); });
+    };
+
+    if (lines.strongest >= 0) addNeighbours(lines.strongest);
+    for (size_t t = 0; t < nodes.size(); ++t) {
+        if (lines.distance[t] == 1) addNeighbours(static_cast<int>(t));
+    }
+    return targets;
 }
 
 std::vector<Map::territoryNode*> AggressivePlayerStrategy::toDefend() const {
-    // TODO: Implement aggressive defense logic (strongest territory)
     if (!player) return {};
     const auto* owned = player->getOwnedTerritories();
     if (!owned || owned->empty()) return {};
-    return {owned->at(0)}; // Placeholder
+    if (!player->getGameState()) return {owned->at(0)};
+
+    const FrontLines lines = analyze();
+    auto& nodes = player->getGameState()->getMap()->getTerritoryNodes();
+    return {&nodes[lines.strongest]};
 }
 
 void AggressivePlayerStrategy::issueOrder() {
-    // TODO: Implement aggressive order issuing
-    std::cout << "[AggressivePlayerStrategy] " << (player ? player->getName() : "Unknown") << " issues aggressive orders.\n";
+    if (!player || !player->getGameState()) {
+        std::cout << "[AggressivePlayerStrategy] " << (player ? player->getName() : "Unknown") << " is not in a running game.\n";
+        return;
+    }
+    const FrontLines lines = analyze();
+    if (lines.strongest < 0) return;
+    auto& nodes = player->getGameState()->getMap()->getTerritoryNodes();
+    Map::territoryNode& strongest = nodes[lines.strongest];
+
+    // Everything goes to the strongest territory on the front.
+    const int pool = player->getReinforcementPool();
+    if (pool > 0) {
+        player->issueOrder(new Deploy(pool, strongest.name));
+        player->setReinforcementPool(0);
+    }
+    const int available = strongest.armies + pool;
+
+    if (lines.distance[lines.strongest] == 1) {
+        // On the front: throw the whole stack at the cheapest neighbouring enemy.
+        const std::vector<float>& threat = player->getGameState()->getThreat(player);
+        Map::territoryNode* target = nullptr;
+        float best = 0.0f;
+        for (int adj : strongest.adjacentIndices) {
+            if (nodes[adj].owner == player) continue;
+            const float c = targetCost(nodes[adj], threat[adj]);
+            if (!target || c < best) {
+                target = &nodes[adj];
+                best = c;
+            }
+        }
+        if (target && available > 0) {
+            player->issueOrder(new Advance(available, strongest.name, target->name));
+        }
+    }
+
+    // Interior stacks march one hop towards the nearest enemy, so armies don't idle behind the lines.
+    for (auto* t : *player->getOwnedTerritories()) {
+        const int id = static_cast<int>(t - nodes.data());
+        if (id == lines.strongest || t->armies <= 0 || lines.distance[id] <= 1) continue;
+        player->issueOrder(new Advance(t->armies, t->name, nodes[lines.next[id]].name));
+    }
 }
 
 // ============================================================================
-// BenevolentPlayerStrategy Implementation (Stub)
+// BenevolentPlayerStrategy Implementation
 // ============================================================================
 
 BenevolentPlayerStrategy::BenevolentPlayerStrategy(Player* p) : PlayerStrategy(p) {}
@@ -445,16 +637,115 @@ std::vector<Map::territoryNode*> BenevolentPlayerStrategy::toAttack() const {
 }
 
 std::vector<Map::territoryNode*> BenevolentPlayerStrategy::toDefend() const {
-    // TODO: Implement benevolent defense logic (weakest territories)
     if (!player) return {};
     const auto* owned = player->getOwnedTerritories();
     if (!owned || owned->empty()) return {};
-    return *owned; // Placeholder
+
+    std::vector<Map::territoryNode*> territories(*owned);
+    if (!player->getGameState()) return territories;
+
+    // Most exposed first.
+    const std::vector<float>& threat = player->getGameState()->getThreat(player);
+    const auto* nodes = player->getGameState()->getMap()->getTerritoryNodes().data();
+    auto strength = [&](const Map::territoryNode* t) { return exposedStrength(*t, threat[t - nodes]); };
+    std::stable_sort(territories.begin(), territories.end(),
+                     [&](const Map::territoryNode* a, const Map::territoryNode* b) { return strength(a) < strength(b); });
+    return territories;
+}
+
+// Armies minus a share of the enemy pressure on the territory, so exposed territories count as weaker.
+int BenevolentPlayerStrategy::exposedStrength(const Map::territoryNode& territory, float threat) {
+    return territory.armies - static_cast<int>(std::lround(THREAT_WEIGHT * threat));
+}
+
+std::vector<std::pair<int, int>> BenevolentPlayerStrategy::planReinforcements(int pool) const {
+    std::vector<std::pair<int, int>> plan;
+    if (!player || !player->getGameState() || pool <= 0) return plan;
+    const auto& nodes = player->getGameState()->getMap()->getTerritoryNodes();
+    const std::vector<float>& threat = player->getGameState()->getThreat(player);
+    auto strength = [&](int id) { return exposedStrength(nodes[id], threat[id]); };
+
+    // Min-heap of (strength, territory id); make_heap is O(n), each pop O(log n).
+    using Entry = std::pair<int, int>;
+    std::vector<Entry> heap;
+    heap.reserve(player->getOwnedTerritories()->size());
+    for (const auto* t : *player->getOwnedTerritories()) {
+        const int id = static_cast<int>(t - nodes.data());
+        heap.emplace_back(strength(id), id);
+    }
+    if (heap.empty()) return plan;
+    std::make_heap(heap.begin(), heap.end(), std::greater<Entry>());
+
+    // Grow a group of the weakest territories, all raised to the same level, while the pool
+    // can afford to bring the whole group up to the next territory's strength.
+    std::vector<int> group;
+    std::pop_heap(heap.begin(), heap.end(), std::greater<Entry>());
+    int level = heap.back().first;
+    group.push_back(heap.back().second);
+    heap.pop_back();
+    while (!heap.empty()) {
+        const int next = heap.front().first;
+        const long long cost = static_cast<long long>(next - level) * static_cast<long long>(group.size());
+        if (cost > pool) break;
+        pool -= static_cast<int>(cost);
+        level = next;
+        std::pop_heap(heap.begin(), heap.end(), std::greater<Entry>());
+        group.push_back(heap.back().second);
+        heap.pop_back();
+    }
+
+    // Spread what's left evenly over the group; one Deploy per territory.
+    const int share = pool / static_cast<int>(group.size());
+    int remainder = pool % static_cast<int>(group.size());
+    for (int id : group) {
+        const int armies = level - strength(id) + share + (remainder > 0 ? 1 : 0);
+        if (remainder > 0) --remainder;
+        if (armies > 0) plan.emplace_back(id, armies);
+    }
+    return plan;
 }
 
 void BenevolentPlayerStrategy::issueOrder() {
-    // TODO: Implement benevolent order issuing
-    std::cout << "[BenevolentPlayerStrategy] " << (player ? player->getName() : "Unknown") << " issues benevolent orders.\n";
+    if (!player || !player->getGameState()) {
+        std::cout << "[BenevolentPlayerStrategy] " << (player ? player->getName() : "Unknown") << " is not in a running game.\n";
+        return;
+    }
+    auto& nodes = player->getGameState()->getMap()->getTerritoryNodes();
+
+    // Armies each territory will hold once this turn's deploys have executed.
+    std::vector<int> projected(nodes.size(), 0);
+    for (const auto* t : *player->getOwnedTerritories()) {
+        projected[t - nodes.data()] = t->armies;
+    }
+
+    const int pool = player->getReinforcementPool();
+    for (const auto& deploy : planReinforcements(pool)) {
+        player->issueOrder(new Deploy(deploy.second, nodes[deploy.first].name));
+        projected[deploy.first] += deploy.second;
+    }
+    player->setReinforcementPool(0);
+
+    // Strong territories send half the difference to their weakest friendly neighbour.
+    // Each territory moves armies at most once, so this is a single O(T+E) pass.
+    std::vector<bool> moved(nodes.size(), false);
+    for (const auto* t : *player->getOwnedTerritories()) {
+        const int id = static_cast<int>(t - nodes.data());
+        if (moved[id]) continue;
+        int weakest = -1;
+        for (int adj : t->adjacentIndices) {
+            if (nodes[adj].owner == player && (weakest < 0 || projected[adj] < projected[weakest])) {
+                weakest = adj;
+            }
+        }
+        if (weakest < 0) continue;
+        const int transfer = (projected[id] - projected[weakest]) / 2;
+        if (transfer <= 0) continue;
+        player->issueOrder(new Advance(transfer, t->name, nodes[weakest].name));
+        projected[id] -= transfer;
+        projected[weakest] += transfer;
+        moved[id] = true;
+        moved[weakest] = true;
+    }
 }
 
 // ============================================================================
@@ -490,13 +781,28 @@ std::vector<Map::territoryNode*> NeutralPlayerStrategy::toDefend() const {
     return *owned;
 }
 
+void NeutralPlayerStrategy::watchForAttacks(Player* player, EventBus& events) {
+    if (!player) return;
+    // The handler replaces the strategy it was called for, so attacks must be published where no
+    // strategy of this player is running: orders execute on the game thread, and Cheater
+    // conquests are published from the serial part of the issue phase, after every concurrent
+    // bot has finished. Publishing from a bot deciding on the pool would break that.
+    events.subscribe(GameEventType::TerritoryAttacked, [player](const GameEvent&) {
+        // Whatever strategy the player has now decides; only a neutral one turns.
+        if (dynamic_cast<NeutralPlayerStrategy*>(player->getStrategy())) {
+            std::cout << "[NeutralPlayerStrategy] " << player->getName() << " was attacked and becomes aggressive.\n";
+            player->setStrategy(new AggressivePlayerStrategy(player));
+        }
+    }, player);
+}
+
 void NeutralPlayerStrategy::issueOrder() {
-    // Neutral never issues orders unless attacked (then becomes aggressive)
+    // Neutral never issues orders; watchForAttacks() swaps in an aggressive strategy once attacked
     std::cout << "[NeutralPlayerStrategy] " << (player ? player->getName() : "Unknown") << " is neutral and issues no orders.\n";
 }
 
 // ============================================================================
-// CheaterPlayerStrategy Implementation (Stub)
+// CheaterPlayerStrategy Implementation
 // ============================================================================
 
 CheaterPlayerStrategy::CheaterPlayerStrategy(Player* p) : PlayerStrategy(p) {}
@@ -517,9 +823,67 @@ PlayerStrategy* CheaterPlayerStrategy::clone() const {
     return new CheaterPlayerStrategy(*this);
 }
 
+namespace {
+
+// Index of the lowest set bit of a non-zero word.
+inline size_t lowestSetBit(uint64_t bits) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+#if defined(_M_X64) || defined(_M_ARM64)
+    _BitScanForward64(&index, bits);
+#else
+    if (!_BitScanForward(&index, static_cast<unsigned long>(bits))) {
+        _BitScanForward(&index, static_cast<unsigned long>(bits >> 32));
+        index += 32;
+    }
+#endif
+    return index;
+#else
+    return static_cast<size_t>(__builtin_ctzll(bits));
+#endif
+}
+
+}
+
+std::vector<uint64_t> CheaterPlayerStrategy::neighbourhood() const {
+    if (!player || !player->getGameState()) return {};
+    const auto& nodes = player->getGameState()->getMap()->getTerritoryNodes();
+    const size_t words = (nodes.size() + 63) / 64;
+
+    std::vector<uint64_t> owned(words, 0), reached(words, 0);
+    const auto* territories = player->getOwnedTerritories();
+    for (const auto* t : *territories) {
+        const size_t id = static_cast<size_t>(t - nodes.data());
+        owned[id >> 6] |= uint64_t(1) << (id & 63);
+    }
+    const MapTopology& topology = player->getGameState()->getTopology();
+    const int* rowStart = topology.getRowStart().data();
+    const int* columns = topology.getColumns().data();
+    for (const auto* t : *territories) {
+        const size_t id = static_cast<size_t>(t - nodes.data());
+        for (int k = rowStart[id]; k < rowStart[id + 1]; ++k) {
+            const int adj = columns[k];
+            reached[static_cast<size_t>(adj) >> 6] |= uint64_t(1) << (adj & 63);
+        }
+    }
+    for (size_t w = 0; w < words; ++w) {
+        reached[w] &= ~owned[w];
+    }
+    return reached;
+}
+
 std::vector<Map::territoryNode*> CheaterPlayerStrategy::toAttack() const {
-    // TODO: Return all adjacent territories
-    return {};
+    const std::vector<uint64_t> targets = neighbourhood();
+    if (targets.empty()) return {};
+    auto& nodes = player->getGameState()->getMap()->getTerritoryNodes();
+
+    std::vector<Map::territoryNode*> result;
+    for (size_t w = 0; w < targets.size(); ++w) {
+        for (uint64_t bits = targets[w]; bits != 0; bits &= bits - 1) {
+            result.push_back(&nodes[w * 64 + lowestSetBit(bits)]);
+        }
+    }
+    return result;
 }
 
 std::vector<Map::territoryNode*> CheaterPlayerStrategy::toDefend() const {
@@ -530,7 +894,487 @@ std::vector<Map::territoryNode*> CheaterPlayerStrategy::toDefend() const {
 }
 
 void CheaterPlayerStrategy::issueOrder() {
-    // TODO: Automatically conquer all adjacent territories
-    std::cout << "[CheaterPlayerStrategy] " << (player ? player->getName() : "Unknown") << " cheats and conquers adjacent territories.\n";
+    if (!player || !player->getGameState()) {
+        std::cout << "[CheaterPlayerStrategy] " << (player ? player->getName() : "Unknown") << " is not in a running game.\n";
+        return;
+    }
+    GameState& state = *player->getGameState();
+
+    // The targets are fixed before anything changes hands, so territories conquered this turn
+    // don't extend the reach until the next one.
+    const std::vector<Map::territoryNode*> targets = toAttack();
+    for (auto* target : targets) {
+        Player* defender = target->owner;
+        state.publish(GameEvent{GameEventType::TerritoryAttacked, player, defender, target});
+        state.setOwner(target, player);
+        state.publish(GameEvent{GameEventType::TerritoryConquered, player, defender, target});
+    }
+    if (!targets.empty()) state.awardConquestCard(player);
+
+    const int pool = player->getReinforcementPool();
+    if (pool > 0 && !player->getOwnedTerritories()->empty()) {
+        player->issueOrder(new Deploy(pool, player->getOwnedTerritories()->front()->name));
+        player->setReinforcementPool(0);
+    }
 }
 
+
+
+// ============================================================================
+// MCTSPlayerStrategy Implementation
+// ============================================================================
+
+MCTSPlayerStrategy::MCTSPlayerStrategy(Player* p, int iterations, int timeBudgetMs, size_t threads)
+    : PlayerStrategy(p),
+      iterationBudget(std::max(1, iterations)),
+      timeBudgetMs(std::max(1, timeBudgetMs)),
+      threads(threads),
+      rolloutRounds(4),
+      maxCandidates(12),
+      expansionVisits(8),
+      exploration(1.4) {}
+
+MCTSPlayerStrategy::MCTSPlayerStrategy(const MCTSPlayerStrategy& other)
+    : PlayerStrategy(other),
+      iterationBudget(other.iterationBudget),
+      timeBudgetMs(other.timeBudgetMs),
+      threads(other.threads),
+      rolloutRounds(other.rolloutRounds),
+      maxCandidates(other.maxCandidates),
+      expansionVisits(other.expansionVisits),
+      exploration(other.exploration) {}
+
+MCTSPlayerStrategy& MCTSPlayerStrategy::operator=(const MCTSPlayerStrategy& other) {
+    if (this != &other) {
+        PlayerStrategy::operator=(other);
+        iterationBudget = other.iterationBudget;
+        timeBudgetMs = other.timeBudgetMs;
+        threads = other.threads;
+        rolloutRounds = other.rolloutRounds;
+        maxCandidates = other.maxCandidates;
+        expansionVisits = other.expansionVisits;
+        exploration = other.exploration;
+    }
+    return *this;
+}
+
+MCTSPlayerStrategy::~MCTSPlayerStrategy() {}
+
+std::string MCTSPlayerStrategy::getStrategyName() const {
+    return "MCTS";
+}
+
+PlayerStrategy* MCTSPlayerStrategy::clone() const {
+    return new MCTSPlayerStrategy(*this);
+}
+
+void MCTSPlayerStrategy::setIterationBudget(int iterations) {
+    iterationBudget = std::max(1, iterations);
+}
+
+void MCTSPlayerStrategy::setTimeBudget(int milliseconds) {
+    timeBudgetMs = std::max(1, milliseconds);
+}
+
+void MCTSPlayerStrategy::setThreads(size_t count) {
+    threads = count;
+}
+
+std::vector<Map::territoryNode*> MCTSPlayerStrategy::toAttack() const {
+    if (!player || !player->getGameState()) return {};
+    auto& nodes = player->getGameState()->getMap()->getTerritoryNodes();
+
+    std::vector<Map::territoryNode*> targets;
+    std::vector<bool> seen(nodes.size(), false);
+    for (auto* t : *player->getOwnedTerritories()) {
+        for (int adj : t->adjacentIndices) {
+            if (nodes[adj].owner != player && !seen[adj]) {
+                seen[adj] = true;
+                targets.push_back(&nodes[adj]);
+            }
+        }
+    }
+    return targets;
+}
+
+std::vector<Map::territoryNode*> MCTSPlayerStrategy::toDefend() const {
+    if (!player) return {};
+    const auto* owned = player->getOwnedTerritories();
+    if (!owned) return {};
+    return *owned;
+}
+
+TurnPlan MCTSPlayerStrategy::search(const GameSnapshot& root, int me, const DecisionContext& context) const {
+    const std::vector<TurnPlan> plans = Simulation::candidatePlans(root, me, maxCandidates);
+    if (plans.size() <= 1) {
+        return plans.empty() ? TurnPlan() : plans.front();
+    }
+
+    struct Stats {
+        int visits = 0;
+        double value = 0.0;
+    };
+    // The player's order sets for its next turn under one root order set, once expanded.
+    struct Expansion {
+        std::vector<TurnPlan> plans;
+        std::vector<Stats> stats;
+        int total = 0;
+    };
+    struct Tree {
+        std::vector<Stats> root;
+        std::vector<Expansion> next;
+    };
+
+    // UCB1 over sibling order sets; unvisited ones go first.
+    auto select = [this](const std::vector<Stats>& stats, int total) {
+        size_t choice = 0;
+        double best = -1.0;
+        for (size_t i = 0; i < stats.size(); ++i) {
+            if (stats[i].visits == 0) return i;
+            const double mean = stats[i].value / stats[i].visits;
+            const double ucb = mean + exploration * std::sqrt(std::log(static_cast<double>(total)) / stats[i].visits);
+            if (ucb > best) {
+                best = ucb;
+                choice = i;
+            }
+        }
+        return choice;
+    };
+
+    // Searches started from a pool worker run inline; waiting on the pool from inside it could deadlock.
+    ThreadPool& pool = ThreadPool::shared();
+    size_t workers = threads ? threads : pool.size();
+    if (context.threads) workers = std::min(workers, context.threads);
+    if (pool.isWorkerThread()) workers = 1;
+    workers = std::max<size_t>(1, workers);
+
+    const auto deadline = std::min(context.deadline, std::chrono::steady_clock::now() + std::chrono::milliseconds(timeBudgetMs));
+    std::atomic<int> remaining(iterationBudget);
+    std::vector<Tree> perWorker(workers, Tree{std::vector<Stats>(plans.size()), std::vector<Expansion>(plans.size())});
+    const uint32_t seed = std::random_device{}();
+
+    // Results from earlier searches of the same position and order set warm up the first worker.
+    TranspositionTable& table = TranspositionTable::shared();
+    std::vector<uint64_t> keys(plans.size());
+    for (size_t i = 0; i < plans.size(); ++i) {
+        const TurnPlan& plan = plans[i];
+        uint64_t planKey = Zobrist::mix(static_cast<uint64_t>(plan.deployTerritory + 1) << 40
+                                        ^ static_cast<uint64_t>(plan.sourceTerritory + 1) << 20
+                                        ^ static_cast<uint64_t>(plan.targetTerritory + 1));
+        keys[i] = root.getHash() ^ Zobrist::mix(planKey ^ static_cast<uint64_t>(me));
+        TranspositionTable::Entry known;
+        if (table.probe(keys[i], known) && known.depth == rolloutRounds) {
+            perWorker[0].root[i].visits = known.visits;
+            perWorker[0].root[i].value = static_cast<double>(known.value) * known.visits;
+        }
+    }
+
+    auto work = [&](size_t w) {
+        std::mt19937 rng(seed + static_cast<uint32_t>(w) * 7919u);
+        std::vector<Stats>& stats = perWorker[w].root;
+        // Warm-started visits count towards the total, or log(total) would start at log(0).
+        int total = 0;
+        for (const Stats& seeded : stats) total += seeded.visits;
+
+        while (remaining.fetch_sub(1, std::memory_order_relaxed) > 0 && std::chrono::steady_clock::now() < deadline &&
+               !context.token.isCancelled()) {
+            const size_t choice = select(stats, total);
+            GameSnapshot state = root;
+            Simulation::applyPlan(state, me, plans[choice], rng);
+
+            // Second ply: once this order set has been tried a few times, the player's next turn is
+            // chosen by UCB1 too instead of by the rollout policy. The tree is open loop: the next
+            // turn's order sets come from the first sampled position and are re-applied to later
+            // samples, where moves that no longer fit are skipped by applyPlan().
+            Expansion& next = perWorker[w].next[choice];
+            size_t reply = SIZE_MAX;
+            if (stats[choice].visits < expansionVisits || rolloutRounds == 0) {
+                Simulation::rollout(state, me, rolloutRounds, rng);
+            } else if (Simulation::playUntilTurn(state, me, rng)) {
+                if (next.plans.empty()) {
+                    next.plans = Simulation::candidatePlans(state, me, maxCandidates);
+                    next.stats.assign(next.plans.size(), Stats());
+                }
+                if (!next.plans.empty()) {
+                    reply = select(next.stats, next.total);
+                    Simulation::applyPlan(state, me, next.plans[reply], rng);
+                }
+                Simulation::rollout(state, me, rolloutRounds - 1, rng);
+            }
+
+            const double result = Simulation::evaluate(state, me);
+            stats[choice].visits++;
+            stats[choice].value += result;
+            ++total;
+            if (reply != SIZE_MAX) {
+                next.stats[reply].visits++;
+                next.stats[reply].value += result;
+                ++next.total;
+            }
+        }
+    };
+
+    std::vector<std::future<void>> pending;
+    for (size_t w = 1; w < workers; ++w) {
+        pending.push_back(pool.submit([&work, w] { work(w); }));
+    }
+    work(0);
+    for (auto& f : pending) f.get();
+
+    size_t chosen = 0;
+    int mostVisits = -1;
+    for (size_t i = 0; i < plans.size(); ++i) {
+        int visits = 0;
+        double value = 0.0;
+        for (const Tree& tree : perWorker) {
+            visits += tree.root[i].visits;
+            value += tree.root[i].value;
+        }
+        if (visits > 0) {
+            TranspositionTable::Entry entry;
+            entry.value = static_cast<float>(value / visits);
+            entry.visits = visits;
+            entry.depth = rolloutRounds;
+            table.store(keys[i], entry);
+        }
+        if (visits > mostVisits) {
+            mostVisits = visits;
+            chosen = i;
+        }
+    }
+    return plans[chosen];
+}
+
+void MCTSPlayerStrategy::issueOrder() {
+    issueOrder(DecisionContext());
+}
+
+void MCTSPlayerStrategy::issueOrder(const DecisionContext& context) {
+    if (!player) {
+        std::cout << "[MCTSPlayerStrategy] Cannot issue orders: player is null.\n";
+        return;
+    }
+    GameState* state = player->getGameState();
+    const int me = state ? state->playerId(player) : -1;
+    if (me < 0) {
+        std::cout << "[MCTSPlayerStrategy] " << player->getName() << " is not in a running game.\n";
+        return;
+    }
+
+    const TurnPlan plan = search(state->snapshot(), me, context);
+    const auto& nodes = state->getMap()->getTerritoryNodes();
+
+    if (plan.deployTerritory >= 0 && plan.deployArmies > 0) {
+        player->issueOrder(new Deploy(plan.deployArmies, nodes[plan.deployTerritory].name));
+        player->setReinforcementPool(player->getReinforcementPool() - plan.deployArmies);
+    }
+    if (plan.sourceTerritory >= 0 && plan.targetTerritory >= 0 && plan.advanceArmies > 0) {
+        player->issueOrder(new Advance(plan.advanceArmies, nodes[plan.sourceTerritory].name, nodes[plan.targetTerritory].name));
+    }
+}
+
+// ============================================================================
+// ScriptedPlayerStrategy Implementation
+// ============================================================================
+
+ScriptedPlayerStrategy::ScriptedPlayerStrategy(Player* p, std::shared_ptr<const StrategyScript> script)
+    : PlayerStrategy(p), script(script ? std::move(script) : std::make_shared<const StrategyScript>()) {}
+
+ScriptedPlayerStrategy::ScriptedPlayerStrategy(const ScriptedPlayerStrategy& other)
+    : PlayerStrategy(other), script(other.script) {}
+
+ScriptedPlayerStrategy& ScriptedPlayerStrategy::operator=(const ScriptedPlayerStrategy& other) {
+    if (this != &other) {
+        PlayerStrategy::operator=(other);
+        script = other.script;
+    }
+    return *this;
+}
+
+ScriptedPlayerStrategy::~ScriptedPlayerStrategy() {}
+
+std::string ScriptedPlayerStrategy::getStrategyName() const {
+    return script->getName();
+}
+
+PlayerStrategy* ScriptedPlayerStrategy::clone() const {
+    return new ScriptedPlayerStrategy(*this);
+}
+
+StrategyScript::Features ScriptedPlayerStrategy::features(int territory, const std::vector<float>& threat,
+                                                          const std::vector<int>& armies) const {
+    const auto& nodes = player->getGameState()->getMap()->getTerritoryNodes();
+    const bool owned = nodes[territory].owner == player;
+
+    int enemies = 0, friends = 0, strongestEnemy = 0, strongestFriend = 0;
+    for (int adj : nodes[territory].adjacentIndices) {
+        if (nodes[adj].owner == player) {
+            ++friends;
+            strongestFriend = std::max(strongestFriend, armies[adj]);
+        } else {
+            ++enemies;
+            strongestEnemy = std::max(strongestEnemy, armies[adj]);
+        }
+    }
+
+    StrategyScript::Features f;
+    f[StrategyScript::Armies] = static_cast<float>(armies[territory]);
+    f[StrategyScript::Threat] = threat[territory];
+    f[StrategyScript::Enemies] = static_cast<float>(enemies);
+    f[StrategyScript::Friends] = static_cast<float>(friends);
+    f[StrategyScript::Advantage] = static_cast<float>(owned ? armies[territory] - strongestEnemy
+                                                            : strongestFriend - armies[territory]);
+    return f;
+}
+
+std::vector<int> ScriptedPlayerStrategy::rankTargets(const std::vector<float>& threat, const std::vector<int>& armies) const {
+    const auto& nodes = player->getGameState()->getMap()->getTerritoryNodes();
+    std::vector<std::pair<float, int>> scored;
+    std::vector<bool> seen(nodes.size(), false);
+    for (const auto* t : *player->getOwnedTerritories()) {
+        for (int adj : t->adjacentIndices) {
+            if (nodes[adj].owner == player || seen[adj]) continue;
+            seen[adj] = true;
+            scored.emplace_back(script->score(StrategyScript::Attack, StrategyScript::Frontier, features(adj, threat, armies)), adj);
+        }
+    }
+    std::stable_sort(scored.begin(), scored.end(),
+                     [](const std::pair<float, int>& a, const std::pair<float, int>& b) { return a.first > b.first; });
+
+    std::vector<int> ranked;
+    ranked.reserve(scored.size());
+    for (const auto& s : scored) ranked.push_back(s.second);
+    return ranked;
+}
+
+std::vector<Map::territoryNode*> ScriptedPlayerStrategy::toAttack() const {
+    if (!player || !player->getGameState()) return {};
+    GameState& state = *player->getGameState();
+    auto& nodes = state.getMap()->getTerritoryNodes();
+    std::vector<int> armies(nodes.size());
+    for (size_t t = 0; t < nodes.size(); ++t) armies[t] = nodes[t].armies;
+
+    std::vector<Map::territoryNode*> targets;
+    for (int id : rankTargets(state.getThreat(player), armies)) targets.push_back(&nodes[id]);
+    return targets;
+}
+
+std::vector<Map::territoryNode*> ScriptedPlayerStrategy::toDefend() const {
+    if (!player) return {};
+    const auto* owned = player->getOwnedTerritories();
+    if (!owned || owned->empty()) return {};
+    if (!player->getGameState()) return *owned;
+
+    GameState& state = *player->getGameState();
+    const auto& nodes = state.getMap()->getTerritoryNodes();
+    const std::vector<float>& threat = state.getThreat(player);
+    std::vector<int> armies(nodes.size());
+    for (size_t t = 0; t < nodes.size(); ++t) armies[t] = nodes[t].armies;
+
+    // Best deploy targets first.
+    std::vector<std::pair<float, Map::territoryNode*>> scored;
+    for (auto* t : *owned) {
+        const int id = static_cast<int>(t - nodes.data());
+        const StrategyScript::Features f = features(id, threat, armies);
+        const auto row = f[StrategyScript::Enemies] > 0 ? StrategyScript::Frontier : StrategyScript::Interior;
+        scored.emplace_back(script->score(StrategyScript::Deploy, row, f), t);
+    }
+    std::stable_sort(scored.begin(), scored.end(),
+                     [](const std::pair<float, Map::territoryNode*>& a, const std::pair<float, Map::territoryNode*>& b) {
+                         return a.first > b.first;
+                     });
+    std::vector<Map::territoryNode*> result;
+    for (const auto& s : scored) result.push_back(s.second);
+    return result;
+}
+
+void ScriptedPlayerStrategy::issueOrder() {
+    if (!player || !player->getGameState()) {
+        std::cout << "[ScriptedPlayerStrategy] " << (player ? player->getName() : "Unknown") << " is not in a running game.\n";
+        return;
+    }
+    GameState& state = *player->getGameState();
+    auto& nodes = state.getMap()->getTerritoryNodes();
+    const std::vector<float>& threat = state.getThreat(player);
+    const auto* owned = player->getOwnedTerritories();
+    if (owned->empty()) return;
+
+    // Armies each territory will hold once the orders issued so far have executed.
+    std::vector<int> armies(nodes.size());
+    for (size_t t = 0; t < nodes.size(); ++t) armies[t] = nodes[t].armies;
+    auto rowOf = [](const StrategyScript::Features& f) {
+        return f[StrategyScript::Enemies] > 0 ? StrategyScript::Frontier : StrategyScript::Interior;
+    };
+
+    // Deploy: the pool is split evenly over the best-scoring territories.
+    const int pool = player->getReinforcementPool();
+    if (pool > 0) {
+        std::vector<std::pair<float, int>> scored;
+        for (const auto* t : *owned) {
+            const int id = static_cast<int>(t - nodes.data());
+            const StrategyScript::Features f = features(id, threat, armies);
+            scored.emplace_back(script->score(StrategyScript::Deploy, rowOf(f), f), id);
+        }
+        const size_t targets = std::min<size_t>(static_cast<size_t>(script->getDeployTargets()), scored.size());
+        std::partial_sort(scored.begin(), scored.begin() + targets, scored.end(),
+                          [](const std::pair<float, int>& a, const std::pair<float, int>& b) { return a.first > b.first; });
+
+        int remaining = pool;
+        for (size_t i = 0; i < targets && remaining > 0; ++i) {
+            const int share = static_cast<int>((pool + targets - 1 - i) / targets);
+            const int id = scored[i].second;
+            player->issueOrder(new Deploy(share, nodes[id].name));
+            armies[id] += share;
+            remaining -= share;
+        }
+        player->setReinforcementPool(0);
+    }
+
+    // Attack: best-scoring targets first, each from the strongest unused neighbouring stack.
+    std::vector<bool> used(nodes.size(), false);
+    int attacks = 0;
+    for (int target : rankTargets(threat, armies)) {
+        if (attacks >= script->getMaxAttacks()) break;
+        int source = -1;
+        for (int adj : nodes[target].adjacentIndices) {
+            if (nodes[adj].owner == player && !used[adj] && (source < 0 || armies[adj] > armies[source])) {
+                source = adj;
+            }
+        }
+        if (source < 0) continue;
+        const int available = armies[source] - 1;
+        if (available <= 0 || available < script->getAttackRatio() * armies[target]) continue;
+
+        player->issueOrder(new Advance(available, nodes[source].name, nodes[target].name));
+        armies[source] -= available;
+        used[source] = true;
+        ++attacks;
+    }
+
+    // Move: interior stacks send a share of their armies to the best-scoring friendly neighbour.
+    if (script->getMoveFraction() <= 0.0f) return;
+    for (const auto* t : *owned) {
+        const int id = static_cast<int>(t - nodes.data());
+        if (used[id]) continue;
+        if (features(id, threat, armies)[StrategyScript::Enemies] > 0) continue;
+        const int amount = static_cast<int>(script->getMoveFraction() * armies[id]);
+        if (amount <= 0) continue;
+
+        int best = -1;
+        float bestScore = 0.0f;
+        for (int adj : t->adjacentIndices) {
+            if (nodes[adj].owner != player) continue;
+            const StrategyScript::Features f = features(adj, threat, armies);
+            const float score = script->score(StrategyScript::Move, rowOf(f), f);
+            if (best < 0 || score > bestScore) {
+                best = adj;
+                bestScore = score;
+            }
+        }
+        if (best < 0) continue;
+        player->issueOrder(new Advance(amount, t->name, nodes[best].name));
+        armies[id] -= amount;
+        armies[best] += amount;
+        used[id] = true;
+    }
+}
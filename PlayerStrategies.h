@@ -7,15 +7,24 @@
 #define COMP345_RISK_PLAYERSTRATEGIES_H
 
 #include "Map.h"
+#include "Simulation.h"
+#include "Decision.h"
+#include "StrategyScript.h"
+#include <memory>
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <utility>
 
 // Forward declarations
 class Player;
+class EventBus;
 class Order;
 class Card;
 class Hand;
 class Deck;
+enum class CardType : uint8_t;
+struct CardTarget;
 
 /**
  * Abstract base class for player strategies.
@@ -37,6 +46,13 @@ public:
      */
     virtual void issueOrder() = 0;
 
+    /**
+     * Issues orders within the given deadline, stopping early if the token is cancelled.
+     * The default ignores the limits and calls issueOrder(); strategies whose decisions can take
+     * long override it and return their best orders so far once context.shouldStop().
+     */
+    virtual void issueOrder(const DecisionContext& context);
+
     /**
      * Determines which territories the player should attack.
      * @return Vector of territories to attack
@@ -61,6 +77,24 @@ public:
      */
     virtual std::string getStrategyName() const = 0;
 
+    /**
+     * True if issueOrder() only reads the game and this player's own pool and orders, so the engine
+     * may run it on a worker thread alongside other players. Strategies that prompt the user or
+     * change the board must keep the default.
+     * @return Whether issueOrder() may run concurrently with other players'
+     */
+    virtual bool canIssueConcurrently() const { return false; }
+
+    /**
+     * Picks what to play a card of the given kind on, for Card::play(). The default targets the
+     * strongest enemy neighbour with bombs, the most threatened own territory with reinforcements
+     * and airlifts (flown in from the biggest stack without enemy neighbours), blockades that
+     * territory only once it cannot hold, and offers diplomacy to the neighbour with most armies
+     * on the border. Strategies that never play cards on their own return false.
+     * @return Whether a target was chosen
+     */
+    virtual bool chooseCardTarget(CardType type, CardTarget& target) const;
+
     /**
      * Sets the player pointer for this strategy.
      * Used when cloning strategies to update the player reference.
@@ -86,6 +120,7 @@ public:
     std::vector<Map::territoryNode*> toDefend() const override;
     PlayerStrategy* clone() const override;
     std::string getStrategyName() const override;
+    bool chooseCardTarget(CardType, CardTarget&) const override { return false; }
 
 private:
     /**
@@ -130,6 +165,24 @@ public:
     std::vector<Map::territoryNode*> toDefend() const override;
     PlayerStrategy* clone() const override;
     std::string getStrategyName() const override;
+    bool canIssueConcurrently() const override { return true; }
+
+private:
+    /**
+     * Result of one multi-source BFS seeded from every territory the player doesn't own.
+     * distance[t] is the number of hops from an owned territory t to the nearest enemy
+     * (1 on the frontier, -1 if not owned or cut off) and next[t] is the neighbour one hop closer.
+     * strongest is the owned frontier territory with most armies, or the strongest owned territory
+     * if no enemy can be reached.
+     */
+    struct FrontLines {
+        std::vector<int> distance;
+        std::vector<int> next;
+        int strongest = -1;
+    };
+
+    FrontLines analyze() const;
+    static float targetCost(const Map::territoryNode& target, float threat);
 };
 
 /**
@@ -148,6 +201,18 @@ public:
     std::vector<Map::territoryNode*> toDefend() const override;
     PlayerStrategy* clone() const override;
     std::string getStrategyName() const override;
+    bool canIssueConcurrently() const override { return true; }
+
+private:
+    /**
+     * Water-fills the pool into the weakest territories: pops them off a min-heap keyed by
+     * exposedStrength() until the pool can no longer lift the whole group to the next level.
+     * O(k log n) for k territories reinforced. Returns (territory id, armies to deploy) pairs.
+     */
+    std::vector<std::pair<int, int>> planReinforcements(int pool) const;
+
+    static constexpr float THREAT_WEIGHT = 0.5f;
+    static int exposedStrength(const Map::territoryNode& territory, float threat);
 };
 
 /**
@@ -166,11 +231,22 @@ public:
     std::vector<Map::territoryNode*> toDefend() const override;
     PlayerStrategy* clone() const override;
     std::string getStrategyName() const override;
+    bool chooseCardTarget(CardType, CardTarget&) const override { return false; }
+    bool canIssueConcurrently() const override { return true; }
+
+    /**
+     * Subscribes the player to attacks on their territories, whatever strategy they have now.
+     * The first attack while the player is neutral gives them an AggressivePlayerStrategy;
+     * until then nothing is polled. Attacks must be published from the thread running the game,
+     * never while the player's strategy is deciding.
+     */
+    static void watchForAttacks(Player* player, EventBus& events);
 };
 
 /**
  * Cheater player strategy.
- * Automatically conquers all adjacent territories.
+ * Automatically conquers all adjacent territories. The conquest happens while issuing orders,
+ * straight through GameState, so this strategy mutates the game state on its turn.
  */
 class CheaterPlayerStrategy : public PlayerStrategy {
 public:
@@ -184,7 +260,106 @@ public:
     std::vector<Map::territoryNode*> toDefend() const override;
     PlayerStrategy* clone() const override;
     std::string getStrategyName() const override;
+
+private:
+    /**
+     * Enemy territories adjacent to the player, as a bitset over territory ids (bit t of word t / 64).
+     * One sweep over the owned territories' adjacency lists, OR-ing bits into the result.
+     */
+    std::vector<uint64_t> neighbourhood() const;
+};
+
+/**
+ * Monte Carlo tree search player strategy.
+ * Picks this turn's orders among candidate order sets (deploy, then attack or hold) with UCT.
+ * The tree has two plies of the player's own decisions: this turn's order sets, and under each
+ * one, once it has been visited a few times, the order sets for the player's next turn. The
+ * opponents' turns in between and everything after the second ply are played out by rollouts,
+ * with a cheap randomized policy for every player on game snapshots.
+ * Independent searches run on the shared thread pool and their root visit counts are merged
+ * (root parallelization), so strength scales with the number of cores.
+ */
+class MCTSPlayerStrategy : public PlayerStrategy {
+public:
+    static constexpr int DEFAULT_ITERATIONS = 4000;
+    static constexpr int DEFAULT_TIME_BUDGET_MS = 250;
+
+    /**
+     * @param iterations Total rollouts per move, across all threads
+     * @param timeBudgetMs Wall-clock limit per move; the search stops at whichever budget runs out first
+     * @param threads Number of parallel searches, 0 for one per pool worker (or for the share of
+     *                the pool the engine allows when several bots decide at once)
+     */
+    MCTSPlayerStrategy(Player* p, int iterations = DEFAULT_ITERATIONS, int timeBudgetMs = DEFAULT_TIME_BUDGET_MS, size_t threads = 0);
+    MCTSPlayerStrategy(const MCTSPlayerStrategy& other);
+    MCTSPlayerStrategy& operator=(const MCTSPlayerStrategy& other);
+    virtual ~MCTSPlayerStrategy();
+
+    void issueOrder() override;
+    void issueOrder(const DecisionContext& context) override;
+    std::vector<Map::territoryNode*> toAttack() const override;
+    std::vector<Map::territoryNode*> toDefend() const override;
+    PlayerStrategy* clone() const override;
+    std::string getStrategyName() const override;
+    bool canIssueConcurrently() const override { return true; }
+
+    void setIterationBudget(int iterations);
+    void setTimeBudget(int milliseconds);
+    void setThreads(size_t count);
+    int getIterationBudget() const { return iterationBudget; }
+    int getTimeBudget() const { return timeBudgetMs; }
+    size_t getThreads() const { return threads; }
+
+private:
+    int iterationBudget;
+    int timeBudgetMs;
+    size_t threads;
+    int rolloutRounds;
+    size_t maxCandidates;
+    int expansionVisits;  // visits of a root order set before its next turn gets a ply of its own
+    double exploration;
+
+    /**
+     * Runs the search from the given position and returns the best order set for the player.
+     * Stops at the first of the iteration budget, the time budget, the context's deadline or its
+     * cancellation; with no rollouts done at all it returns the hold plan.
+     */
+    TurnPlan search(const GameSnapshot& root, int me, const DecisionContext& context) const;
 };
 
+/**
+ * Scripted player strategy.
+ * Follows a StrategyScript: deploys to the best-scoring territories, attacks the best-scoring
+ * targets it can afford and moves interior armies towards the best-scoring neighbours.
+ * Instances built from the same script share it.
+ */
+class ScriptedPlayerStrategy : public PlayerStrategy {
+public:
+    ScriptedPlayerStrategy(Player* p, std::shared_ptr<const StrategyScript> script);
+    ScriptedPlayerStrategy(const ScriptedPlayerStrategy& other);
+    ScriptedPlayerStrategy& operator=(const ScriptedPlayerStrategy& other);
+    virtual ~ScriptedPlayerStrategy();
+
+    void issueOrder() override;
+    std::vector<Map::territoryNode*> toAttack() const override;
+    std::vector<Map::territoryNode*> toDefend() const override;
+    PlayerStrategy* clone() const override;
+    std::string getStrategyName() const override;
+    bool canIssueConcurrently() const override { return true; }
+
+    const StrategyScript& getScript() const { return *script; }
+
+private:
+    std::shared_ptr<const StrategyScript> script;
+
+    StrategyScript::Features features(int territory, const std::vector<float>& threat, const std::vector<int>& armies) const;
+    // Enemy territories next to the player, best score first.
+    std::vector<int> rankTargets(const std::vector<float>& threat, const std::vector<int>& armies) const;
+};
+
+void testAggressivePlayer();
+void testBenevolentPlayer();
+void testCheaterPlayer();
+
 #endif // COMP345_RISK_PLAYERSTRATEGIES_H
 
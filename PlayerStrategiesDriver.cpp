@@ -0,0 +1,166 @@
+//
+// PlayerStrategiesDriver.cpp
+// Driver for the bot player strategies.
+//
+
+#include "PlayerStrategies.h"
+#include "GameState.h"
+#include "Player.h"
+#include "Orders.h"
+#include "Map.h"
+#include "DriverCheck.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Whether the order is a Deploy of the given armies to the given territory.
+bool isDeploy(const Order* order, int armies, const std::string& to) {
+    const auto* deploy = dynamic_cast<const Deploy*>(order);
+    return deploy && deploy->getArmyUnits() == armies && deploy->getTargetTerritory() == to;
+}
+
+// Whether the order is an Advance of the given armies between the given territories.
+bool isAdvance(const Order* order, int armies, const std::string& from, const std::string& to) {
+    const auto* advance = dynamic_cast<const Advance*>(order);
+    return advance && advance->getArmyUnits() == armies && advance->getSourceTerritory() == from &&
+           advance->getTargetTerritory() == to;
+}
+
+// Hands each territory to its owner with the given armies and puts both players in one game.
+struct StrategyGame {
+    Map map;
+    Player ann{"Ann"};
+    Player bo{"Bo"};
+    std::unique_ptr<GameState> state;
+
+    StrategyGame(Map board, const std::string& owners, const std::vector<int>& armies) : map(std::move(board)) {
+        auto& nodes = map.getTerritoryNodes();
+        for (size_t t = 0; t < nodes.size(); ++t) {
+            (owners[t] == 'A' ? ann : bo).addTerritory(&nodes[t]);
+            nodes[t].armies = armies[t];
+        }
+        state = std::make_unique<GameState>(&map, std::vector<Player*>{&ann, &bo}, nullptr, 345);
+        ann.setGameState(state.get());
+        bo.setGameState(state.get());
+    }
+};
+
+}
+
+void testAggressivePlayer() {
+    std::cout << "=== Aggressive Player Driver ===\n";
+
+    // A chain of Ann's territories leading to Bo's: Rear - Middle - Front - {Fort, Camp}.
+    // Rear is Ann's strongest territory but sits three hops behind the front.
+    StrategyGame game(Map("Aggressive demo", {{"Land", 1}}, {
+        {"Rear", "Land", {"Middle"}},
+        {"Middle", "Land", {"Rear", "Front"}},
+        {"Front", "Land", {"Middle", "Fort", "Camp"}},
+        {"Fort", "Land", {"Front"}},
+        {"Camp", "Land", {"Front"}},
+    }), "AAABB", {20, 5, 6, 9, 2});
+    game.ann.setReinforcementPool(4);
+    game.ann.setStrategy(new AggressivePlayerStrategy(&game.ann));
+    game.ann.issueOrder();
+
+    const OrdersList* orders = game.ann.getOrdersList();
+    check(orders->size() == 4, "Ann issues a deploy, an attack and a march for each interior stack");
+    check(isDeploy(orders->getOrder(0), 4, "Front"),
+          "the whole pool goes to the strongest frontier territory, not the stronger one in the rear");
+    check(isAdvance(orders->getOrder(1), 10, "Front", "Camp"),
+          "the front stack attacks the cheapest neighbouring enemy");
+    check(isAdvance(orders->getOrder(2), 20, "Rear", "Middle") && isAdvance(orders->getOrder(3), 5, "Middle", "Front"),
+          "interior stacks march one hop along the shortest path to the front");
+    check(game.ann.getReinforcementPool() == 0, "the pool is spent");
+
+    // With no enemy in reach, the pool goes to the strongest territory and nothing moves.
+    StrategyGame island(Map("Island demo", {{"Land", 1}}, {
+        {"West", "Land", {"East"}},
+        {"East", "Land", {"West"}},
+        {"Far", "Land", {}},
+    }), "AAB", {3, 7, 1});
+    island.ann.setReinforcementPool(2);
+    island.ann.setStrategy(new AggressivePlayerStrategy(&island.ann));
+    island.ann.issueOrder();
+    const OrdersList* cutOff = island.ann.getOrdersList();
+    check(cutOff->size() == 1 && isDeploy(cutOff->getOrder(0), 2, "East"),
+          "cut off from every enemy, the pool goes to the strongest territory");
+
+    std::cout << "=== End of Aggressive Player Driver ===\n";
+}
+
+void testBenevolentPlayer() {
+    std::cout << "=== Benevolent Player Driver ===\n";
+
+    // Bo is out of reach, so no territory of Ann's is under threat and strength is just armies.
+    StrategyGame game(Map("Benevolent demo", {{"Land", 1}}, {
+        {"P", "Land", {"Q"}},
+        {"Q", "Land", {"P", "R"}},
+        {"R", "Land", {"Q", "S"}},
+        {"S", "Land", {"R"}},
+        {"Far", "Land", {}},
+    }), "AAAAB", {1, 3, 4, 10, 1});
+    game.ann.setReinforcementPool(7);
+    game.ann.setStrategy(new BenevolentPlayerStrategy(&game.ann));
+    game.ann.issueOrder();
+
+    // Raising P to 3 costs 2, raising P and Q to 4 costs 2 more, and S at 10 is out of reach:
+    // the last 3 armies are shared evenly, leaving P, Q and R at 5 each.
+    const OrdersList* orders = game.ann.getOrdersList();
+    check(orders->size() == 4, "Ann issues three deploys and one transfer");
+    check(isDeploy(orders->getOrder(0), 4, "P") && isDeploy(orders->getOrder(1), 2, "Q") &&
+          isDeploy(orders->getOrder(2), 1, "R"),
+          "the pool water-fills the three weakest territories up to the same level");
+    check(isAdvance(orders->getOrder(3), 2, "S", "R"),
+          "the strongest territory sends half the difference to its weakest neighbour");
+    check(game.ann.getReinforcementPool() == 0, "the pool is spent");
+
+    std::cout << "=== End of Benevolent Player Driver ===\n";
+}
+
+void testCheaterPlayer() {
+    std::cout << "=== Cheater Player Driver ===\n";
+
+    // A chain of 70 territories, so the neighbourhood spans two 64-bit words. Ann holds T0 and T65.
+    const int count = 70;
+    std::vector<Map::territory> chain;
+    std::string owners(count, 'B');
+    for (int t = 0; t < count; ++t) {
+        std::vector<std::string> adjacent;
+        if (t > 0) adjacent.push_back("T" + std::to_string(t - 1));
+        if (t + 1 < count) adjacent.push_back("T" + std::to_string(t + 1));
+        chain.push_back({"T" + std::to_string(t), "Land", adjacent});
+    }
+    owners[0] = owners[65] = 'A';
+    StrategyGame game(Map("Cheater demo", {{"Land", 1}}, chain), owners, std::vector<int>(count, 3));
+    game.ann.setStrategy(new CheaterPlayerStrategy(&game.ann));
+
+    std::vector<std::string> targets;
+    for (const auto* t : game.ann.toAttack()) targets.push_back(t->name);
+    check(targets == std::vector<std::string>{"T1", "T64", "T66"},
+          "the targets are exactly the enemy neighbours, in territory order across both words");
+
+    game.ann.issueOrder();
+    std::vector<std::string> owned;
+    for (const auto& node : game.map.getTerritoryNodes()) {
+        if (node.owner == &game.ann) owned.push_back(node.name);
+    }
+    check(owned == std::vector<std::string>{"T0", "T1", "T64", "T65", "T66"},
+          "Ann conquers exactly the adjacent enemy territories");
+    check(game.map.getTerritoryNodes()[2].owner == &game.bo && game.map.getTerritoryNodes()[63].owner == &game.bo,
+          "nothing is reached through territories conquered this turn");
+
+    std::cout << "=== End of Cheater Player Driver ===\n";
+}
+
+/**
+int main() {
+    testAggressivePlayer();
+    testBenevolentPlayer();
+    testCheaterPlayer();
+    return 0;
+}
+ */
@@ -0,0 +1,105 @@
+//
+// SharedDeck.cpp
+// Deck that many threads draw from and return to at once.
+//
+
+#include "SharedDeck.h"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+static_assert(CARD_TYPE_COUNT * SharedDeck::COUNT_BITS <= 64, "card counts must fit one word");
+
+namespace {
+
+// Numbers the threads that touch any SharedDeck, for home shards and random streams.
+size_t threadIndex() {
+    static std::atomic<size_t> next{0};
+    thread_local const size_t index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+}
+
+SharedDeck::SharedDeck(int size, size_t shardCount)
+    : shards(shardCount > 0 ? shardCount : std::max(1u, std::thread::hardware_concurrency())) {
+    std::vector<uint64_t> counts(shards.size(), 0);
+    for (int i = 0; i < size; ++i) {
+        const int kind = i % CARD_TYPE_COUNT;
+        uint64_t& shard = counts[static_cast<size_t>(i / CARD_TYPE_COUNT) % counts.size()];
+        if (kindCount(shard, kind) == MAX_PER_SHARD) {
+            throw std::invalid_argument("SharedDeck: too many cards per shard, use more shards");
+        }
+        shard += uint64_t{1} << (kind * COUNT_BITS);
+    }
+    for (size_t s = 0; s < shards.size(); ++s) {
+        shards[s].counts.store(counts[s], std::memory_order_relaxed);
+    }
+}
+
+std::optional<CardType> SharedDeck::draw() {
+    const size_t home = homeShard();
+    for (size_t step = 0; step < shards.size(); ++step) {
+        std::atomic<uint64_t>& word = shards[(home + step) % shards.size()].counts;
+        uint64_t counts = word.load(std::memory_order_relaxed);
+        for (;;) {
+            int total = 0;
+            for (int kind = 0; kind < CARD_TYPE_COUNT; ++kind) total += kindCount(counts, kind);
+            if (total == 0) break;
+
+            int pick = std::uniform_int_distribution<int>(0, total - 1)(rng());
+            int kind = 0;
+            while (pick >= kindCount(counts, kind)) pick -= kindCount(counts, kind++);
+
+            // On failure counts is reloaded and the card picked again from what is really there.
+            if (word.compare_exchange_weak(counts, counts - (uint64_t{1} << (kind * COUNT_BITS)),
+                                           std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                return static_cast<CardType>(kind);
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+bool SharedDeck::returnCard(CardType type) {
+    const int kind = static_cast<int>(type);
+    const size_t home = homeShard();
+    for (size_t step = 0; step < shards.size(); ++step) {
+        std::atomic<uint64_t>& word = shards[(home + step) % shards.size()].counts;
+        uint64_t counts = word.load(std::memory_order_relaxed);
+        while (kindCount(counts, kind) < MAX_PER_SHARD) {
+            if (word.compare_exchange_weak(counts, counts + (uint64_t{1} << (kind * COUNT_BITS)),
+                                           std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+size_t SharedDeck::size() const {
+    size_t total = 0;
+    for (const Shard& shard : shards) {
+        const uint64_t counts = shard.counts.load(std::memory_order_acquire);
+        for (int kind = 0; kind < CARD_TYPE_COUNT; ++kind) total += kindCount(counts, kind);
+    }
+    return total;
+}
+
+size_t SharedDeck::count(CardType type) const {
+    size_t total = 0;
+    for (const Shard& shard : shards) {
+        total += kindCount(shard.counts.load(std::memory_order_acquire), static_cast<int>(type));
+    }
+    return total;
+}
+
+size_t SharedDeck::homeShard() const {
+    return threadIndex() % shards.size();
+}
+
+std::mt19937_64& SharedDeck::rng() {
+    // Distinct seed per thread, mixed so neighbouring thread numbers give unrelated streams.
+    thread_local std::mt19937_64 gen(std::random_device{}() ^ ((threadIndex() + 1) * 0x9E3779B97F4A7C15ull));
+    return gen;
+}
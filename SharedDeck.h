@@ -0,0 +1,78 @@
+//
+// SharedDeck.h
+// Deck that many threads draw from and return to at once.
+//
+
+#ifndef COMP345_RISK_SHAREDDECK_H
+#define COMP345_RISK_SHAREDDECK_H
+
+#include "Cards.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+/**
+ * A deck shared by several game tables running on different threads, e.g. a tournament deck.
+ *
+ * Cards of one kind are interchangeable, so a pile of cards is fully described by how many of each
+ * kind it holds. SharedDeck packs those five counts into one 64-bit word, which makes draw and
+ * return a single compare-and-swap: no locks, and a draw is uniform over the cards in that word.
+ *
+ * To keep threads from fighting over one word, the cards are dealt round-robin into shards, each on
+ * its own cache line. A thread starts at its own shard and only moves on to the next one when its
+ * shard is empty (draw) or full (return), so with as many shards as threads most operations touch
+ * memory no other thread is writing. Every thread draws with its own random stream.
+ */
+class SharedDeck {
+public:
+    static constexpr int COUNT_BITS = 12;
+    // Most cards of one kind a single shard can hold.
+    static constexpr int MAX_PER_SHARD = (1 << COUNT_BITS) - 1;
+
+    /**
+     * Same cards as Deck(size), dealt over the given number of shards (0 for one per hardware thread).
+     * Throws std::invalid_argument if a shard would have to hold more than MAX_PER_SHARD of a kind.
+     */
+    explicit SharedDeck(int size, size_t shards = 0);
+    SharedDeck(const SharedDeck& other) = delete;
+    SharedDeck& operator=(const SharedDeck& other) = delete;
+
+    // Random card, or nothing if every shard is empty.
+    std::optional<CardType> draw();
+
+    /**
+     * Puts a card back. Fails only if every shard already holds MAX_PER_SHARD cards of that kind.
+     * @return Whether the card was returned
+     */
+    bool returnCard(CardType type);
+
+    /**
+     * Cards left, in total or of one kind. Exact only while no other thread draws or returns.
+     */
+    size_t size() const;
+    size_t count(CardType type) const;
+
+    size_t shardCount() const { return shards.size(); }
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> counts{0};
+    };
+
+    std::vector<Shard> shards;
+
+    static int kindCount(uint64_t counts, int kind) {
+        return static_cast<int>((counts >> (kind * COUNT_BITS)) & MAX_PER_SHARD);
+    }
+
+    // Shard this thread starts at.
+    size_t homeShard() const;
+    static std::mt19937_64& rng();
+};
+
+void testSharedDeck();
+
+#endif // COMP345_RISK_SHAREDDECK_H
@@ -0,0 +1,220 @@
+//
+// Simulation.cpp
+// Fast turn simulation on game snapshots for AI search.
+//
+
+#include "Simulation.h"
+#include "Battle.h"
+#include <algorithm>
+
+namespace {
+
+void countOwned(const GameSnapshot& state, std::vector<int>& owned) {
+    std::fill(owned.begin(), owned.end(), 0);
+    for (int t = 0; t < state.territoryCount(); ++t) {
+        const int owner = state.getOwner(t);
+        if (owner >= 0) ++owned[owner];
+    }
+}
+
+// Gives every player still on the board its reinforcements. Returns how many there are.
+int reinforceLiving(GameSnapshot& state, const std::vector<int>& owned) {
+    int alive = 0;
+    for (int p = 0; p < state.playerCount(); ++p) {
+        if (owned[p] == 0) continue;
+        ++alive;
+        state.setReinforcementPool(p, state.getReinforcementPool(p) + std::max(3, owned[p] / 3));
+    }
+    return alive;
+}
+
+}
+
+namespace Simulation {
+
+int reinforcementFor(const GameSnapshot& state, int player) {
+    return std::max(3, state.territoriesOwned(player) / 3);
+}
+
+std::vector<TurnPlan> candidatePlans(const GameSnapshot& state, int player, size_t maxPlans) {
+    const auto& nodes = state.getMap()->getTerritoryNodes();
+    const int pool = state.getReinforcementPool(player);
+    BattleTable& table = BattleTable::shared();
+
+    struct Scored {
+        double odds;
+        TurnPlan plan;
+    };
+    std::vector<Scored> attacks;
+    int holdTerritory = -1;
+    int holdThreat = -1;
+    int anyOwned = -1;
+
+    for (int t = 0; t < state.territoryCount(); ++t) {
+        if (state.getOwner(t) != player) continue;
+        if (anyOwned < 0) anyOwned = t;
+
+        const int available = state.getArmies(t) + pool;
+        int threat = 0;
+        for (int adj : nodes[t].adjacentIndices) {
+            if (state.getOwner(adj) == player) continue;
+            threat += state.getArmies(adj);
+            if (available <= 1) continue;
+
+            TurnPlan plan;
+            plan.deployTerritory = t;
+            plan.deployArmies = pool;
+            plan.sourceTerritory = t;
+            plan.targetTerritory = adj;
+            plan.advanceArmies = available - 1;
+            attacks.push_back({table.conquestProbability(plan.advanceArmies, state.getArmies(adj)), plan});
+        }
+        if (threat > holdThreat) {
+            holdThreat = threat;
+            holdTerritory = t;
+        }
+    }
+
+    std::vector<TurnPlan> plans;
+    if (anyOwned < 0) return plans;
+
+    TurnPlan hold;
+    hold.deployTerritory = holdTerritory >= 0 ? holdTerritory : anyOwned;
+    hold.deployArmies = pool;
+    plans.push_back(hold);
+
+    const size_t keep = maxPlans > 1 ? std::min(attacks.size(), maxPlans - 1) : 0;
+    std::partial_sort(attacks.begin(), attacks.begin() + keep, attacks.end(),
+                      [](const Scored& a, const Scored& b) { return a.odds > b.odds; });
+    for (size_t i = 0; i < keep; ++i) {
+        plans.push_back(attacks[i].plan);
+    }
+    return plans;
+}
+
+TurnPlan rolloutPlan(const GameSnapshot& state, int player, std::mt19937& rng) {
+    const auto& nodes = state.getMap()->getTerritoryNodes();
+    const int pool = state.getReinforcementPool(player);
+
+    // Reservoir-sample one frontier territory so a rollout turn is a single pass over the map.
+    int frontier = -1;
+    int seen = 0;
+    for (int t = 0; t < state.territoryCount(); ++t) {
+        if (state.getOwner(t) != player) continue;
+        for (int adj : nodes[t].adjacentIndices) {
+            if (state.getOwner(adj) != player) {
+                if (std::uniform_int_distribution<int>(0, seen)(rng) == 0) frontier = t;
+                ++seen;
+                break;
+            }
+        }
+    }
+
+    TurnPlan plan;
+    if (frontier < 0) return plan;
+    plan.deployTerritory = frontier;
+    plan.deployArmies = pool;
+
+    int weakest = -1;
+    for (int adj : nodes[frontier].adjacentIndices) {
+        if (state.getOwner(adj) == player) continue;
+        if (weakest < 0 || state.getArmies(adj) < state.getArmies(weakest)) weakest = adj;
+    }
+    const int available = state.getArmies(frontier) + pool;
+    if (weakest >= 0 && available - 1 > state.getArmies(weakest)) {
+        plan.sourceTerritory = frontier;
+        plan.targetTerritory = weakest;
+        plan.advanceArmies = available - 1;
+    }
+    return plan;
+}
+
+void applyPlan(GameSnapshot& state, int player, const TurnPlan& plan, std::mt19937& rng) {
+    if (plan.deployTerritory >= 0 && state.getOwner(plan.deployTerritory) == player) {
+        const int deploy = std::min(plan.deployArmies, state.getReinforcementPool(player));
+        state.setArmies(plan.deployTerritory, state.getArmies(plan.deployTerritory) + deploy);
+        state.setReinforcementPool(player, state.getReinforcementPool(player) - deploy);
+    }
+
+    const int source = plan.sourceTerritory;
+    const int target = plan.targetTerritory;
+    if (source < 0 || target < 0 || state.getOwner(source) != player) return;
+
+    const int moving = std::min(plan.advanceArmies, state.getArmies(source));
+    if (moving <= 0) return;
+
+    if (state.getOwner(target) == player) {
+        state.setArmies(source, state.getArmies(source) - moving);
+        state.setArmies(target, state.getArmies(target) + moving);
+        return;
+    }
+
+    const int defenders = state.getArmies(target);
+    BattleOutcome outcome = BattleTable::shared().sample(moving, defenders, rng);
+    const int survivors = moving - outcome.attackerLosses;
+    if (outcome.defenderLosses >= defenders && survivors > 0) {
+        state.setArmies(source, state.getArmies(source) - moving);
+        state.setOwner(target, player);
+        state.setArmies(target, survivors);
+    } else {
+        state.setArmies(source, state.getArmies(source) - outcome.attackerLosses);
+        state.setArmies(target, defenders - outcome.defenderLosses);
+    }
+}
+
+void rollout(GameSnapshot& state, int afterPlayer, int rounds, std::mt19937& rng) {
+    const int players = state.playerCount();
+    std::vector<int> owned(players, 0);
+
+    countOwned(state, owned);
+    for (int p = afterPlayer + 1; p < players; ++p) {
+        if (owned[p] == 0) continue;
+        applyPlan(state, p, rolloutPlan(state, p, rng), rng);
+    }
+
+    for (int round = 0; round < rounds; ++round) {
+        countOwned(state, owned);
+        if (reinforceLiving(state, owned) <= 1) return;
+
+        for (int p = 0; p < players; ++p) {
+            if (owned[p] == 0) continue;
+            applyPlan(state, p, rolloutPlan(state, p, rng), rng);
+        }
+    }
+}
+
+bool playUntilTurn(GameSnapshot& state, int player, std::mt19937& rng) {
+    rollout(state, player, 0, rng);
+
+    std::vector<int> owned(state.playerCount(), 0);
+    countOwned(state, owned);
+    if (owned[player] == 0 || reinforceLiving(state, owned) <= 1) return false;
+    for (int p = 0; p < player; ++p) {
+        if (owned[p] == 0) continue;
+        applyPlan(state, p, rolloutPlan(state, p, rng), rng);
+    }
+    return state.territoriesOwned(player) > 0;
+}
+
+double evaluate(const GameSnapshot& state, int player) {
+    int territories = 0, ownTerritories = 0;
+    long long armies = 0, ownArmies = 0;
+    for (int t = 0; t < state.territoryCount(); ++t) {
+        const int owner = state.getOwner(t);
+        if (owner < 0) continue;
+        ++territories;
+        armies += state.getArmies(t);
+        if (owner == player) {
+            ++ownTerritories;
+            ownArmies += state.getArmies(t);
+        }
+    }
+    if (territories == 0 || ownTerritories == 0) return 0.0;
+    if (ownTerritories == territories) return 1.0;
+
+    const double territoryShare = static_cast<double>(ownTerritories) / territories;
+    const double armyShare = armies > 0 ? static_cast<double>(ownArmies) / armies : territoryShare;
+    return 0.7 * territoryShare + 0.3 * armyShare;
+}
+
+}
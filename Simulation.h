@@ -0,0 +1,67 @@
+//
+// Simulation.h
+// Fast turn simulation on game snapshots for AI search.
+//
+
+#ifndef COMP345_RISK_SIMULATION_H
+#define COMP345_RISK_SIMULATION_H
+
+#include "GameSnapshot.h"
+#include <random>
+#include <vector>
+
+/**
+ * The orders one player issues in a simulated turn: deploy the pool to one territory,
+ * then optionally advance from one territory into a neighbour. -1 means "none".
+ */
+struct TurnPlan {
+    int deployTerritory = -1;
+    int deployArmies = 0;
+    int sourceTerritory = -1;
+    int targetTerritory = -1;
+    int advanceArmies = 0;
+};
+
+/**
+ * Simplified rules for rollouts on a GameSnapshot. Battles are sampled from the shared
+ * BattleTable, so a simulated battle costs a table lookup whatever the stack sizes.
+ */
+namespace Simulation {
+    /**
+     * Armies a player receives at the start of a turn, as in the engine's reinforcement phase.
+     */
+    int reinforcementFor(const GameSnapshot& state, int player);
+
+    /**
+     * Sensible order sets for a player this turn, best first by conquest odds. Always contains at
+     * least one plan (deploy and hold) when the player owns a territory.
+     */
+    std::vector<TurnPlan> candidatePlans(const GameSnapshot& state, int player, size_t maxPlans);
+
+    /**
+     * Cheap randomized policy used for every player during rollouts.
+     */
+    TurnPlan rolloutPlan(const GameSnapshot& state, int player, std::mt19937& rng);
+
+    void applyPlan(GameSnapshot& state, int player, const TurnPlan& plan, std::mt19937& rng);
+
+    /**
+     * Plays the rest of the current round after the given player, then full rounds where every
+     * living player is reinforced and follows rolloutPlan().
+     */
+    void rollout(GameSnapshot& state, int afterPlayer, int rounds, std::mt19937& rng);
+
+    /**
+     * Plays the rest of the current round after the given player, reinforces every living player
+     * and plays the ones before it, all with rolloutPlan(), so the player is next to move.
+     * @return False if the player was eliminated or no opponent is left
+     */
+    bool playUntilTurn(GameSnapshot& state, int player, std::mt19937& rng);
+
+    /**
+     * Value of a position for a player in [0, 1]: 1 if it owns every territory, 0 if it owns none.
+     */
+    double evaluate(const GameSnapshot& state, int player);
+}
+
+#endif // COMP345_RISK_SIMULATION_H
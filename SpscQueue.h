@@ -0,0 +1,91 @@
+//
+// SpscQueue.h
+// Bounded lock-free queue between one producer thread and one consumer thread.
+//
+
+#ifndef COMP345_RISK_SPSCQUEUE_H
+#define COMP345_RISK_SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * Ring buffer for exactly one thread pushing and one thread popping at a time.
+ *
+ * Each side owns one index and only reads the other's, so push and pop are a load, a slot write
+ * and a release store, with no locks and no compare-and-swap. The indices sit on separate cache
+ * lines and each side keeps a cached copy of the other's index, so the line is only pulled across
+ * when the queue looks full (producer) or empty (consumer).
+ *
+ * Slots are reused in place: push assigns into the slot and pop swaps it with the caller's object.
+ * For strings that means both sides keep recycling the same buffers and a steady stream of short
+ * commands allocates nothing.
+ */
+template <typename T>
+class SpscQueue {
+public:
+    // Capacity is rounded up to a power of two.
+    explicit SpscQueue(size_t capacity) : slots(roundUp(capacity)), mask(slots.size() - 1) {}
+    SpscQueue(const SpscQueue& other) = delete;
+    SpscQueue& operator=(const SpscQueue& other) = delete;
+
+    /**
+     * Producer only. Assigns value into the next free slot.
+     * @return False if the queue is full
+     */
+    template <typename U>
+    bool tryPush(U&& value) {
+        const size_t head = producer.index.load(std::memory_order_relaxed);
+        if (head - producer.otherCached == slots.size()) {
+            producer.otherCached = consumer.index.load(std::memory_order_acquire);
+            if (head - producer.otherCached == slots.size()) return false;
+        }
+        slots[head & mask] = std::forward<U>(value);
+        producer.index.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer only. Swaps the oldest value into out; out's old contents go back into the slot.
+     * @return False if the queue is empty
+     */
+    bool tryPop(T& out) {
+        using std::swap;
+        const size_t tail = consumer.index.load(std::memory_order_relaxed);
+        if (tail == consumer.otherCached) {
+            consumer.otherCached = producer.index.load(std::memory_order_acquire);
+            if (tail == consumer.otherCached) return false;
+        }
+        swap(out, slots[tail & mask]);
+        consumer.index.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only. Whether tryPop() would fail right now.
+    bool empty() const {
+        return consumer.index.load(std::memory_order_relaxed) == producer.index.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return slots.size(); }
+
+private:
+    struct alignas(64) Side {
+        std::atomic<size_t> index{0};  // written only by this side
+        size_t otherCached = 0;        // last value seen of the other side's index
+    };
+
+    std::vector<T> slots;
+    size_t mask;
+    Side producer;
+    Side consumer;
+
+    static size_t roundUp(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        return size;
+    }
+};
+
+#endif // COMP345_RISK_SPSCQUEUE_H
@@ -0,0 +1,140 @@
+//
+// StrategyRegistry.cpp
+// Strategy lookup by name: built-in factories plus any registered by plugins.
+//
+
+#include "StrategyRegistry.h"
+#include "PlayerStrategies.h"
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+
+using BuiltInFactory = std::unique_ptr<PlayerStrategy> (*)(Player*);
+
+template <typename S>
+std::unique_ptr<PlayerStrategy> make(Player* player) {
+    return std::make_unique<S>(player);
+}
+
+struct BuiltIn {
+    std::string_view name;
+    BuiltInFactory create;
+};
+
+// Lowercase and sorted; the static_assert below keeps it that way.
+constexpr BuiltIn BUILT_INS[] = {
+    {"aggressive", &make<AggressivePlayerStrategy>},
+    {"benevolent", &make<BenevolentPlayerStrategy>},
+    {"cheater", &make<CheaterPlayerStrategy>},
+    {"human", &make<HumanPlayerStrategy>},
+    {"mcts", &make<MCTSPlayerStrategy>},
+    {"neutral", &make<NeutralPlayerStrategy>},
+};
+constexpr size_t BUILT_IN_COUNT = sizeof(BUILT_INS) / sizeof(BUILT_INS[0]);
+
+constexpr bool builtInsSorted() {
+    for (size_t i = 1; i < BUILT_IN_COUNT; ++i) {
+        if (!(BUILT_INS[i - 1].name < BUILT_INS[i].name)) return false;
+    }
+    return true;
+}
+static_assert(builtInsSorted(), "BUILT_INS must be sorted and free of duplicates");
+
+// Longest name the allocation-free lookup lowercases on the stack; longer names can't be built-ins.
+constexpr size_t MAX_BUILT_IN_NAME = 32;
+
+const BuiltIn* findBuiltIn(const std::string& name) {
+    if (name.size() > MAX_BUILT_IN_NAME) return nullptr;
+    char buffer[MAX_BUILT_IN_NAME];
+    for (size_t i = 0; i < name.size(); ++i) {
+        buffer[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(name[i])));
+    }
+    const std::string_view key(buffer, name.size());
+
+    size_t low = 0, high = BUILT_IN_COUNT;
+    while (low < high) {
+        const size_t mid = (low + high) / 2;
+        if (BUILT_INS[mid].name < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low < BUILT_IN_COUNT && BUILT_INS[low].name == key ? &BUILT_INS[low] : nullptr;
+}
+
+std::string lowercase(const std::string& name) {
+    std::string result = name;
+    std::transform(result.begin(), result.end(), result.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return result;
+}
+
+struct Plugins {
+    std::shared_mutex mutex;
+    std::unordered_map<std::string, StrategyRegistry::Factory> factories;
+    std::vector<std::string> order;
+};
+
+// Function-local so plugins registering during static initialization find it constructed.
+Plugins& plugins() {
+    static Plugins instance;
+    return instance;
+}
+
+}
+
+std::unique_ptr<PlayerStrategy> StrategyRegistry::create(const std::string& name, Player* player) {
+    if (const BuiltIn* builtIn = findBuiltIn(name)) {
+        return builtIn->create(player);
+    }
+    Plugins& registry = plugins();
+    Factory factory;
+    {
+        std::shared_lock<std::shared_mutex> lock(registry.mutex);
+        auto it = registry.factories.find(lowercase(name));
+        if (it == registry.factories.end()) return nullptr;
+        factory = it->second;
+    }
+    return factory(player);
+}
+
+bool StrategyRegistry::contains(const std::string& name) {
+    if (findBuiltIn(name)) return true;
+    Plugins& registry = plugins();
+    std::shared_lock<std::shared_mutex> lock(registry.mutex);
+    return registry.factories.count(lowercase(name)) != 0;
+}
+
+bool StrategyRegistry::add(const std::string& name, Factory factory, bool replace) {
+    if (name.empty() || !factory || findBuiltIn(name)) return false;
+    const std::string key = lowercase(name);
+    Plugins& registry = plugins();
+    std::unique_lock<std::shared_mutex> lock(registry.mutex);
+    auto it = registry.factories.find(key);
+    if (it != registry.factories.end()) {
+        if (!replace) return false;
+        it->second = std::move(factory);
+        return true;
+    }
+    registry.factories.emplace(key, std::move(factory));
+    registry.order.push_back(key);
+    return true;
+}
+
+std::vector<std::string> StrategyRegistry::names() {
+    std::vector<std::string> result;
+    for (const BuiltIn& builtIn : BUILT_INS) {
+        result.emplace_back(builtIn.name);
+    }
+    Plugins& registry = plugins();
+    std::shared_lock<std::shared_mutex> lock(registry.mutex);
+    result.insert(result.end(), registry.order.begin(), registry.order.end());
+    return result;
+}
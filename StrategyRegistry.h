@@ -0,0 +1,60 @@
+//
+// StrategyRegistry.h
+// Strategy lookup by name: built-in factories plus any registered by plugins.
+//
+
+#ifndef COMP345_RISK_STRATEGYREGISTRY_H
+#define COMP345_RISK_STRATEGYREGISTRY_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Player;
+class PlayerStrategy;
+
+/**
+ * Creates strategies by name, case-insensitively.
+ *
+ * Built-in strategies live in a sorted array fixed at compile time and are found by binary
+ * search without allocating. Plugins add their own factories at runtime with add() or a
+ * static Registration; those are looked up after the built-ins. Lookups may run on several
+ * threads at once, also while a plugin registers.
+ */
+class StrategyRegistry {
+public:
+    using Factory = std::function<std::unique_ptr<PlayerStrategy>(Player*)>;
+
+    /**
+     * New strategy for the player, or nullptr if no strategy has that name.
+     */
+    static std::unique_ptr<PlayerStrategy> create(const std::string& name, Player* player);
+
+    static bool contains(const std::string& name);
+
+    /**
+     * Registers a factory under a new name. Names already taken, by a built-in or an earlier
+     * plugin, are refused unless replace is set; built-ins can never be replaced.
+     * @return Whether the factory was registered
+     */
+    static bool add(const std::string& name, Factory factory, bool replace = false);
+
+    /**
+     * Every registered name, built-ins first, in lowercase.
+     */
+    static std::vector<std::string> names();
+
+    /**
+     * Registers a factory during static initialization, for plugins compiled into the program:
+     *
+     *     static StrategyRegistry::Registration cautious("cautious", [](Player* p) { ... });
+     */
+    struct Registration {
+        Registration(const std::string& name, Factory factory) { add(name, std::move(factory)); }
+    };
+};
+
+void testStrategyRegistry();
+
+#endif // COMP345_RISK_STRATEGYREGISTRY_H
@@ -0,0 +1,55 @@
+//
+// StrategyRegistryDriver.cpp
+// Driver for looking up strategies by name.
+//
+
+#include "StrategyRegistry.h"
+#include "PlayerStrategies.h"
+#include "Player.h"
+#include "DriverCheck.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+
+void testStrategyRegistry() {
+    std::cout << "=== Strategy Registry Driver ===\n";
+
+    Player ann("Ann");
+    const auto aggressive = StrategyRegistry::create("AgGrEsSiVe", &ann);
+    check(dynamic_cast<AggressivePlayerStrategy*>(aggressive.get()) != nullptr,
+          "built-in names are found whatever their case");
+    check(!StrategyRegistry::create("nobody", &ann) && !StrategyRegistry::contains("nobody"),
+          "an unknown name creates nothing");
+
+    const StrategyRegistry::Factory benevolent = [](Player* p) { return std::make_unique<BenevolentPlayerStrategy>(p); };
+    check(!StrategyRegistry::add("Aggressive", benevolent) && !StrategyRegistry::add("aggressive", benevolent, true),
+          "built-ins can't be replaced, not even with replace set");
+    check(dynamic_cast<AggressivePlayerStrategy*>(StrategyRegistry::create("aggressive", &ann).get()) != nullptr,
+          "the built-in still creates its own strategy");
+
+    // Plugins stay registered for the rest of the process, so the name is one no other driver uses.
+    const std::string plugin = "Driver-Plugin";
+    check(StrategyRegistry::add(plugin, benevolent) && StrategyRegistry::contains("driver-plugin"),
+          "a plugin registers under a new name, found case-insensitively");
+    check(dynamic_cast<BenevolentPlayerStrategy*>(StrategyRegistry::create("DRIVER-PLUGIN", &ann).get()) != nullptr,
+          "the plugin's factory creates its strategy");
+    const StrategyRegistry::Factory neutral = [](Player* p) { return std::make_unique<NeutralPlayerStrategy>(p); };
+    check(!StrategyRegistry::add(plugin, neutral), "a taken plugin name is refused without replace");
+    check(StrategyRegistry::add(plugin, neutral, true) &&
+          dynamic_cast<NeutralPlayerStrategy*>(StrategyRegistry::create(plugin, &ann).get()) != nullptr,
+          "replace swaps the plugin's factory");
+
+    const auto names = StrategyRegistry::names();
+    check(names.front() == "aggressive" && std::count(names.begin(), names.end(), "driver-plugin") == 1,
+          "names() lists the built-ins first and the plugin once, in lowercase");
+
+    std::cout << "=== End of Strategy Registry Driver ===\n";
+}
+
+/**
+int main() {
+    testStrategyRegistry();
+    return 0;
+}
+ */
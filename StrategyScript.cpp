@@ -0,0 +1,126 @@
+//
+// StrategyScript.cpp
+// Data-driven bot behaviour: weighted rules loaded from a file and compiled into a decision table.
+//
+
+#include "StrategyScript.h"
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+int lookup(const std::string& word, const std::vector<std::string>& names) {
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == word) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+const std::vector<std::string> ACTION_NAMES = {"deploy", "attack", "move"};
+const std::vector<std::string> FEATURE_NAMES = {"armies", "threat", "enemies", "friends", "advantage"};
+
+}
+
+StrategyScript::StrategyScript()
+    : name("Scripted"), deployTargets(1), attackRatio(1.0f), maxAttacks(1), moveFraction(0.0f) {
+    for (auto& action : weights) {
+        for (auto& row : action) row.fill(0.0f);
+    }
+}
+
+StrategyScript StrategyScript::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open strategy script: " + path);
+    }
+    return parse(file, path);
+}
+
+StrategyScript StrategyScript::parse(std::istream& in, const std::string& source) {
+    StrategyScript script;
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        script.text += line;
+        script.text += '\n';
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+
+        std::istringstream words(line);
+        std::vector<std::string> tokens;
+        for (std::string word; words >> word;) tokens.push_back(word);
+        if (tokens.empty()) continue;
+
+        auto fail = [&](const std::string& why) {
+            throw std::runtime_error("Invalid strategy script " + source + ":" + std::to_string(lineNumber) + ": " + why);
+        };
+        auto number = [&](const std::string& text) {
+            try {
+                size_t used = 0;
+                const float value = std::stof(text, &used);
+                if (used != text.size()) fail("not a number: " + text);
+                // stof accepts "nan" and "inf", which would slip through every range check below.
+                if (!std::isfinite(value)) fail("not a finite number: " + text);
+                return value;
+            } catch (const std::logic_error&) {
+                fail("not a number: " + text);
+            }
+            return 0.0f;
+        };
+
+        const std::string& keyword = tokens[0];
+        const int action = lookup(keyword, ACTION_NAMES);
+
+        if (action >= 0) {
+            // <action> [where] <max|min> <feature> [weight]; attacks have no "where".
+            size_t next = 1;
+            bool interior = true, frontier = true;
+            if (action != Attack && tokens.size() > next) {
+                if (tokens[next] == "frontier") {
+                    interior = false;
+                    ++next;
+                } else if (tokens[next] == "interior") {
+                    frontier = false;
+                    ++next;
+                } else if (tokens[next] == "any") {
+                    ++next;
+                }
+            }
+            if (tokens.size() < next + 2 || tokens.size() > next + 3) fail("expected " + keyword + " [where] <max|min> <feature> [weight]");
+            float sign = 0.0f;
+            if (tokens[next] == "max") sign = 1.0f;
+            else if (tokens[next] == "min") sign = -1.0f;
+            else fail("expected max or min, got " + tokens[next]);
+            const int feature = lookup(tokens[next + 1], FEATURE_NAMES);
+            if (feature < 0) fail("unknown feature " + tokens[next + 1]);
+            const float weight = tokens.size() == next + 3 ? number(tokens[next + 2]) : 1.0f;
+
+            if (interior) script.weights[action][Interior][feature] += sign * weight;
+            if (frontier) script.weights[action][Frontier][feature] += sign * weight;
+        } else if (tokens.size() != 2) {
+            fail("expected <setting> <value>");
+        } else if (keyword == "name") {
+            script.name = tokens[1];
+        } else if (keyword == "deploy_targets") {
+            script.deployTargets = static_cast<int>(number(tokens[1]));
+            if (script.deployTargets < 1) fail("deploy_targets must be at least 1");
+        } else if (keyword == "attack_ratio") {
+            script.attackRatio = number(tokens[1]);
+            if (script.attackRatio < 0.0f) fail("attack_ratio must not be negative");
+        } else if (keyword == "max_attacks") {
+            script.maxAttacks = static_cast<int>(number(tokens[1]));
+            if (script.maxAttacks < 0) fail("max_attacks must not be negative");
+        } else if (keyword == "move_fraction") {
+            script.moveFraction = number(tokens[1]);
+            if (script.moveFraction < 0.0f || script.moveFraction > 1.0f) fail("move_fraction must be between 0 and 1");
+        } else {
+            fail("unknown statement " + keyword);
+        }
+    }
+    return script;
+}
@@ -0,0 +1,85 @@
+//
+// StrategyScript.h
+// Data-driven bot behaviour: weighted rules loaded from a file and compiled into a decision table.
+//
+
+#ifndef COMP345_RISK_STRATEGYSCRIPT_H
+#define COMP345_RISK_STRATEGYSCRIPT_H
+
+#include <array>
+#include <istream>
+#include <string>
+
+/**
+ * A strategy script, compiled.
+ *
+ * Scripts are plain text, one statement per line, '#' starts a comment:
+ *
+ *     name Turtle
+ *     deploy frontier max threat 2.0      # <action> <where> <max|min> <feature> [weight]
+ *     deploy any min armies 1
+ *     attack max advantage 1.5            # attack targets are always on the frontier
+ *     move interior max threat 1
+ *     deploy_targets 2                    # settings, see below
+ *     attack_ratio 1.2
+ *
+ * Every rule adds +weight (max) or -weight (min) times a feature to the score of a candidate
+ * territory. Rules are folded at load time into one weight row per action and territory kind
+ * (frontier or interior), so scoring a candidate during a turn is a single row lookup and a
+ * dot product over FEATURE_COUNT floats; the rule text is never looked at again.
+ *
+ * Features, for an owned territory (deploy / move candidates) or an enemy one (attack targets):
+ *   armies      armies on the territory
+ *   threat      enemy pressure on it (see InfluenceMap)
+ *   enemies     adjacent territories not owned by the player
+ *   friends     adjacent territories owned by the player
+ *   advantage   owned: armies minus the largest adjacent enemy stack;
+ *               target: the strongest adjacent owned stack minus the target's armies
+ *
+ * Malformed scripts throw std::runtime_error naming the file and line.
+ */
+class StrategyScript {
+public:
+    enum Action { Deploy = 0, Attack, Move, ACTION_COUNT };
+    enum Feature { Armies = 0, Threat, Enemies, Friends, Advantage, FEATURE_COUNT };
+    enum Row { Interior = 0, Frontier = 1, ROW_COUNT };
+
+    using Features = std::array<float, FEATURE_COUNT>;
+
+    StrategyScript();
+
+    static StrategyScript load(const std::string& path);
+    static StrategyScript parse(std::istream& in, const std::string& source);
+
+    float score(Action action, Row row, const Features& features) const {
+        const Features& w = weights[action][row];
+        float sum = 0.0f;
+        for (int f = 0; f < FEATURE_COUNT; ++f) sum += w[f] * features[f];
+        return sum;
+    }
+
+    const std::string& getName() const { return name; }
+    // The script as written, so a checkpoint can rebuild it without the file.
+    const std::string& getText() const { return text; }
+
+    // How many of the best-scoring territories share the reinforcement pool.
+    int getDeployTargets() const { return deployTargets; }
+    // Attack only when the source has at least this many times the target's armies.
+    float getAttackRatio() const { return attackRatio; }
+    int getMaxAttacks() const { return maxAttacks; }
+    // Share of an interior territory's armies moved towards its best-scoring neighbour each turn.
+    float getMoveFraction() const { return moveFraction; }
+
+private:
+    std::string name;
+    std::string text;
+    std::array<std::array<Features, ROW_COUNT>, ACTION_COUNT> weights;
+    int deployTargets;
+    float attackRatio;
+    int maxAttacks;
+    float moveFraction;
+};
+
+void testStrategyScripts();
+
+#endif // COMP345_RISK_STRATEGYSCRIPT_H
@@ -0,0 +1,90 @@
+//
+// StrategyScriptDriver.cpp
+// Driver for compiling strategy scripts.
+//
+
+#include "StrategyScript.h"
+#include "DriverCheck.h"
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// The message parse() throws for the given text, or an empty string if it compiles.
+std::string parseError(const std::string& text) {
+    std::istringstream in(text);
+    try {
+        StrategyScript::parse(in, "driver.rules");
+    } catch (const std::runtime_error& e) {
+        return e.what();
+    }
+    return "";
+}
+
+}
+
+void testStrategyScripts() {
+    std::cout << "=== Strategy Script Driver ===\n";
+
+    std::istringstream text(
+        "# a comment line\n"
+        "name Driver\n"
+        "\n"
+        "deploy frontier max threat 2.0   # trailing comment\n"
+        "deploy any min armies 1\n"
+        "attack max advantage 1.5\n"
+        "deploy_targets 2\n"
+        "attack_ratio 1.25\n");
+    const StrategyScript script = StrategyScript::parse(text, "driver.rules");
+    check(script.getName() == "Driver", "the script is named by its name statement");
+
+    StrategyScript::Features features{};
+    features[StrategyScript::Armies] = 3.0f;
+    features[StrategyScript::Threat] = 1.0f;
+    features[StrategyScript::Advantage] = 4.0f;
+    check(script.score(StrategyScript::Deploy, StrategyScript::Frontier, features) == -1.0f &&
+          script.score(StrategyScript::Deploy, StrategyScript::Interior, features) == -3.0f,
+          "deploy rules fold into one weight row per territory kind");
+    check(script.score(StrategyScript::Attack, StrategyScript::Frontier, features) == 6.0f,
+          "attack rules apply without a where");
+    check(script.getDeployTargets() == 2 && script.getAttackRatio() == 1.25f, "settings are read");
+
+    const StrategyScript turtle = StrategyScript::load("Strategies/Turtle.rules");
+    check(turtle.getName() == "Turtle" && turtle.getAttackRatio() == 3.0f, "Strategies/Turtle.rules compiles");
+
+    check(parseError("name A\nfly high\n").find("driver.rules:2: unknown statement fly") != std::string::npos,
+          "an unknown statement is rejected with its file and line");
+    check(parseError("deploy max wealth\n").find("unknown feature wealth") != std::string::npos,
+          "an unknown feature is rejected");
+    check(parseError("deploy most armies\n").find("expected max or min") != std::string::npos,
+          "a rule without max or min is rejected");
+    check(parseError("attack max armies 2x\n").find("not a number: 2x") != std::string::npos,
+          "a weight with trailing characters is rejected");
+    check(parseError("attack max armies nan\n").find("not a finite number") != std::string::npos &&
+          parseError("attack max armies inf\n").find("not a finite number") != std::string::npos,
+          "non-finite weights are rejected");
+    check(parseError("move_fraction nan\n").find("not a finite number") != std::string::npos,
+          "non-finite settings are rejected");
+    check(parseError("move_fraction 1.5\n").find("between 0 and 1") != std::string::npos &&
+          parseError("deploy_targets 0\n").find("at least 1") != std::string::npos,
+          "settings out of range are rejected");
+
+    bool missing = false;
+    try {
+        StrategyScript::load("Strategies/missing.rules");
+    } catch (const std::runtime_error&) {
+        missing = true;
+    }
+    check(missing, "a script file that doesn't exist is rejected");
+
+    std::cout << "=== End of Strategy Script Driver ===\n";
+}
+
+/**
+int main() {
+    testStrategyScripts();
+    return 0;
+}
+ */
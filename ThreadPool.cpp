@@ -0,0 +1,53 @@
+//
+// ThreadPool.cpp
+// Fixed-size pool of worker threads for AI search.
+//
+
+#include "ThreadPool.h"
+
+namespace {
+thread_local const ThreadPool* currentPool = nullptr;
+}
+
+ThreadPool::ThreadPool(size_t threads) : stopping(false) {
+    if (threads == 0) threads = 1;
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::workerLoop() {
+    currentPool = this;
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) return;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+bool ThreadPool::isWorkerThread() const {
+    return currentPool == this;
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(std::thread::hardware_concurrency());
+    return pool;
+}
@@ -0,0 +1,65 @@
+//
+// ThreadPool.h
+// Fixed-size pool of worker threads for AI search.
+//
+
+#ifndef COMP345_RISK_THREADPOOL_H
+#define COMP345_RISK_THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed set of worker threads pulling tasks from one queue.
+ *
+ * A task that waits on other tasks of the same pool can deadlock it once every worker waits,
+ * so code that may run on one of its workers should check isWorkerThread() and run inline instead.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads);
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+    ~ThreadPool();
+
+    template <typename F>
+    std::future<void> submit(F&& task) {
+        auto packaged = std::make_shared<std::packaged_task<void()>>(std::forward<F>(task));
+        std::future<void> result = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace_back([packaged] { (*packaged)(); });
+        }
+        available.notify_one();
+        return result;
+    }
+
+    size_t size() const { return workers.size(); }
+
+    /**
+     * True when called from one of this pool's workers.
+     */
+    bool isWorkerThread() const;
+
+    /**
+     * Pool shared by all strategies, one worker per hardware thread.
+     */
+    static ThreadPool& shared();
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping;
+
+    void workerLoop();
+};
+
+#endif // COMP345_RISK_THREADPOOL_H
@@ -0,0 +1,92 @@
+//
+// TranspositionTable.cpp
+// Lock-free table of search results keyed by position hash, shared by search threads.
+//
+
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <cstring>
+
+TranspositionTable::TranspositionTable(size_t megabytes) : bucketCount(1) {
+    const size_t wanted = std::max<size_t>(1, megabytes) * 1024 * 1024 / sizeof(Bucket);
+    // Round down to a power of two so the bucket index is a mask.
+    while (bucketCount * 2 <= wanted) bucketCount *= 2;
+    buckets.reset(new Bucket[bucketCount]);
+    clear();
+}
+
+TranspositionTable& TranspositionTable::shared() {
+    static TranspositionTable table(16);
+    return table;
+}
+
+// Layout: value (32 bits) | visits (16) | depth (8) | bestMove + 1 (8).
+uint64_t TranspositionTable::pack(const Entry& entry) {
+    uint32_t valueBits;
+    std::memcpy(&valueBits, &entry.value, sizeof(valueBits));
+    const uint64_t visits = static_cast<uint64_t>(std::min(std::max(entry.visits, 0), 0xFFFF));
+    const uint64_t depth = static_cast<uint64_t>(std::min(std::max(entry.depth, 0), 0xFF));
+    const uint64_t move = static_cast<uint64_t>(std::min(std::max(entry.bestMove + 1, 0), 0xFF));
+    return static_cast<uint64_t>(valueBits) << 32 | visits << 16 | depth << 8 | move;
+}
+
+TranspositionTable::Entry TranspositionTable::unpack(uint64_t data) {
+    Entry entry;
+    const uint32_t valueBits = static_cast<uint32_t>(data >> 32);
+    std::memcpy(&entry.value, &valueBits, sizeof(valueBits));
+    entry.visits = static_cast<int>((data >> 16) & 0xFFFF);
+    entry.depth = depthOf(data);
+    entry.bestMove = static_cast<int>(data & 0xFF) - 1;
+    return entry;
+}
+
+int TranspositionTable::depthOf(uint64_t data) {
+    return static_cast<int>((data >> 8) & 0xFF);
+}
+
+bool TranspositionTable::probe(uint64_t key, Entry& out) const {
+    const Bucket& bucket = buckets[key & (bucketCount - 1)];
+    for (const Slot& slot : bucket.slots) {
+        const uint64_t data = slot.data.load(std::memory_order_relaxed);
+        const uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if ((check ^ data) == key && data != 0) {
+            out = unpack(data);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, const Entry& entry) {
+    Bucket& bucket = buckets[key & (bucketCount - 1)];
+    const uint64_t data = pack(entry);
+
+    // Same key: refresh in place. Otherwise evict the shallowest entry.
+    Slot* victim = &bucket.slots[0];
+    int victimDepth = 256;
+    for (Slot& slot : bucket.slots) {
+        const uint64_t current = slot.data.load(std::memory_order_relaxed);
+        const uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if ((check ^ current) == key && current != 0) {
+            victim = &slot;
+            break;
+        }
+        const int depth = current == 0 ? -1 : depthOf(current);
+        if (depth < victimDepth) {
+            victimDepth = depth;
+            victim = &slot;
+        }
+    }
+
+    victim->data.store(data, std::memory_order_relaxed);
+    victim->check.store(key ^ data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear() {
+    for (size_t b = 0; b < bucketCount; ++b) {
+        for (Slot& slot : buckets[b].slots) {
+            slot.data.store(0, std::memory_order_relaxed);
+            slot.check.store(0, std::memory_order_relaxed);
+        }
+    }
+}
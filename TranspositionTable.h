@@ -0,0 +1,71 @@
+//
+// TranspositionTable.h
+// Lock-free table of search results keyed by position hash, shared by search threads.
+//
+
+#ifndef COMP345_RISK_TRANSPOSITIONTABLE_H
+#define COMP345_RISK_TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Fixed-size transposition table for lookahead strategies, keyed by a 64-bit position hash
+ * (see GameState::getHash() and GameSnapshot::getHash()).
+ *
+ * Slots are grouped in buckets of four that fill one cache line. A store keeps the entry for
+ * the same key if it has one, otherwise it evicts the shallowest entry of the bucket.
+ *
+ * The table takes no locks. Each slot holds two 64-bit atomics: the packed entry, and the key
+ * XOR the packed entry. A reader accepts a slot only if the two still XOR back to its key, so
+ * an entry torn by a concurrent writer reads as a miss instead of as wrong data.
+ */
+class TranspositionTable {
+public:
+    struct Entry {
+        float value = 0.0f;   // average result, from the point of view of the searching player
+        int visits = 0;       // saturates at 65535
+        int depth = 0;        // search depth or rollout length behind the value, 0-255
+        int bestMove = -1;    // index of the best move found, -1 if none, up to 254
+    };
+
+    static constexpr size_t BUCKET_SIZE = 4;
+
+    explicit TranspositionTable(size_t megabytes);
+    TranspositionTable(const TranspositionTable& other) = delete;
+    TranspositionTable& operator=(const TranspositionTable& other) = delete;
+
+    bool probe(uint64_t key, Entry& out) const;
+    void store(uint64_t key, const Entry& entry);
+    void clear();
+
+    size_t capacity() const { return bucketCount * BUCKET_SIZE; }
+
+    /**
+     * Table shared by every strategy in the process (16 MB).
+     */
+    static TranspositionTable& shared();
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check;  // key ^ data
+        std::atomic<uint64_t> data;
+    };
+
+    struct alignas(64) Bucket {
+        Slot slots[BUCKET_SIZE];
+    };
+
+    std::unique_ptr<Bucket[]> buckets;
+    size_t bucketCount;
+
+    static uint64_t pack(const Entry& entry);
+    static Entry unpack(uint64_t data);
+    static int depthOf(uint64_t data);
+};
+
+void testTranspositionTable();
+
+#endif // COMP345_RISK_TRANSPOSITIONTABLE_H
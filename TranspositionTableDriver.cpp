@@ -0,0 +1,91 @@
+//
+// TranspositionTableDriver.cpp
+// Driver for the shared transposition table.
+//
+
+#include "TranspositionTable.h"
+#include "DriverCheck.h"
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+void testTranspositionTable() {
+    std::cout << "=== Transposition Table Driver ===\n";
+
+    TranspositionTable table(1);
+    TranspositionTable::Entry entry;
+    check(!table.probe(12345, entry), "an empty table misses");
+
+    TranspositionTable::Entry stored;
+    stored.value = 0.625f;
+    stored.visits = 42;
+    stored.depth = 6;
+    stored.bestMove = 3;
+    table.store(12345, stored);
+    check(table.probe(12345, entry) && entry.value == stored.value && entry.visits == 42 && entry.depth == 6 &&
+              entry.bestMove == 3,
+          "a stored entry probes back unchanged");
+    check(!table.probe(12346, entry), "a different key misses");
+
+    stored.visits = 1000000;
+    table.store(12345, stored);
+    check(table.probe(12345, entry) && entry.visits == 65535, "storing the same key again replaces it, visits saturate");
+
+    // Keys that differ only above the bucket mask share a bucket; a fifth one evicts the shallowest.
+    const uint64_t stride = table.capacity() / TranspositionTable::BUCKET_SIZE;
+    const int depths[] = {5, 1, 7, 3};
+    for (uint64_t i = 0; i < 4; ++i) {
+        TranspositionTable::Entry filler;
+        filler.depth = depths[i];
+        filler.visits = 1;
+        table.store(7 + i * stride, filler);
+    }
+    TranspositionTable::Entry newcomer;
+    newcomer.depth = 4;
+    newcomer.visits = 1;
+    table.store(7 + 4 * stride, newcomer);
+    check(!table.probe(7 + stride, entry) && table.probe(7, entry) && table.probe(7 + 2 * stride, entry) &&
+              table.probe(7 + 3 * stride, entry) && table.probe(7 + 4 * stride, entry),
+          "a full bucket evicts its shallowest entry");
+
+    // Writers hammer one key with entries whose fields agree with each other; a reader must only
+    // ever see whole entries, never half of one write and half of another.
+    table.clear();
+    std::atomic<bool> done(false);
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 2; ++w) {
+        writers.emplace_back([&table, w] {
+            for (int i = 0; i < 500000; ++i) {
+                const int n = (i * 2 + w) & 0xFFFF;
+                TranspositionTable::Entry write;
+                write.value = static_cast<float>(n);
+                write.visits = n;
+                write.depth = n & 0xFF;
+                table.store(99, write);
+            }
+        });
+    }
+    long long reads = 0, torn = 0;
+    std::thread reader([&] {
+        TranspositionTable::Entry read;
+        while (!done.load()) {
+            if (!table.probe(99, read)) continue;
+            ++reads;
+            if (static_cast<int>(read.value) != read.visits || (read.visits & 0xFF) != read.depth) ++torn;
+        }
+    });
+    for (auto& writer : writers) writer.join();
+    done = true;
+    reader.join();
+    check(torn == 0, std::to_string(reads) + " concurrent probes saw only whole entries");
+
+    std::cout << "=== End of Transposition Table Driver ===\n";
+}
+
+/**
+int main() {
+    testTranspositionTable();
+    return 0;
+}
+ */
@@ -0,0 +1,62 @@
+//
+// Zobrist.h
+// Zobrist keys for hashing game positions.
+//
+
+#ifndef COMP345_RISK_ZOBRIST_H
+#define COMP345_RISK_ZOBRIST_H
+
+#include <cstdint>
+
+/**
+ * Keys for incremental 64-bit Zobrist hashing of a position.
+ *
+ * A position hash is the XOR of one key per (territory, owner), one per (territory, army bucket),
+ * one for the current player and one for the phase. Keys are derived from a fixed mixing
+ * function instead of a random table, so they work for any map size and every process
+ * computes the same hash for the same position, which replay verification relies on.
+ * Unowned territories, empty territories and "no player / no phase" contribute 0.
+ */
+namespace Zobrist {
+    constexpr int ARMY_BUCKETS = 32;
+
+    inline uint64_t mix(uint64_t z) {
+        z += 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * Armies 0-4 get their own bucket, larger stacks share a bucket per half power of two.
+     */
+    inline int armyBucket(int armies) {
+        if (armies <= 4) return armies < 0 ? 0 : armies;
+        int log = 0;
+        for (unsigned v = static_cast<unsigned>(armies); v > 1; v >>= 1) ++log;
+        const int halfStep = (armies >> (log - 1)) & 1;
+        const int bucket = 5 + 2 * (log - 2) + halfStep;
+        return bucket < ARMY_BUCKETS ? bucket : ARMY_BUCKETS - 1;
+    }
+
+    inline uint64_t ownerKey(int territory, int player) {
+        if (player < 0) return 0;
+        return mix((static_cast<uint64_t>(territory) << 8 | static_cast<uint64_t>(player)) ^ 0x0100000000000000ull);
+    }
+
+    inline uint64_t armyKey(int territory, int armies) {
+        const int bucket = armyBucket(armies);
+        if (bucket == 0) return 0;
+        return mix((static_cast<uint64_t>(territory) << 8 | static_cast<uint64_t>(bucket)) ^ 0x0200000000000000ull);
+    }
+
+    inline uint64_t currentPlayerKey(int player) {
+        return player < 0 ? 0 : mix(static_cast<uint64_t>(player) ^ 0x0300000000000000ull);
+    }
+
+    inline uint64_t phaseKey(int phase) {
+        return phase < 0 ? 0 : mix(static_cast<uint64_t>(phase) ^ 0x0400000000000000ull);
+    }
+}
+
+#endif // COMP345_RISK_ZOBRIST_H